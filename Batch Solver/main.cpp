@@ -0,0 +1,654 @@
+//
+//  main.cpp
+//  Batch Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Command-line batch solver: solves many puzzles across a pool of worker threads
+// and writes the results in input order, with the time that each one took.
+// It reads the formats that PuzzleReader does, and writes the results in the same format or another one,
+// so it also converts puzzle files from one format to another.
+//
+// It is a pipeline: a parser thread, the solver workers, each with its own board manager,
+// and a writer thread, passing puzzles along a fixed ring of slots.
+// So it uses the same memory however many puzzles there are, and it starts writing results
+// as soon as the first ones are solved.
+// Built with SOLVER_STATS defined as 1, its JSON output has each puzzle's technique statistics.
+//
+
+#include "BoardManager.hpp"
+#include "SolverParameters.h"
+#include "PuzzleReader.hpp"
+#include "PuzzleBinary.hpp"
+#include "SolveCache.hpp"
+#include "SudokuConstants.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+using namespace std;
+
+
+static void Usage(const char *Name)
+{
+    fprintf(stderr,
+        "Usage: %s [options] [file ...]\n"
+        "Reads standard input if there are no files\n"
+        "  -f text|line|binary  input format (default: from the start of the file)\n"
+        "  -o text|line|binary|json  output format (default: the input format);\n"
+        "                json is one line per puzzle with its result and statistics\n"
+        "  -n 0|1        only convert the puzzles to the output format, without solving them (default 0)\n"
+        "  -b RxC        block dimensions for line-format puzzles (default: from the line length)\n"
+        "  -j N          number of worker threads (default: all of them)\n"
+        "  -q N          number of puzzles in the pipeline at once (default 1024)\n"
+        "  -v N          maximum visible-set size (default 5)\n"
+        "  -e N          maximum hidden-set size (default 5)\n"
+        "  -i 0|1        use intersections (default 1)\n"
+        "  -k N          maximum fish size, 0 for none (default 4)\n"
+        "  -y 0|1        use XY-Wings (default 1)\n"
+        "  -z 0|1        use XYZ-Wings (default 1)\n"
+        "  -d 0|1        use single-digit coloring (default 1)\n"
+        "  -s N          search, with set size N at each node (default: no search)\n"
+        "  -p N          split each search across N threads, 0 for one per processor (default 1)\n"
+        "  -c N          count solutions, up to N\n"
+        "  -g 0|1        grade each puzzle in one solve: the biggest visible and hidden sets,\n"
+        "                whether intersections were needed, the biggest fish, and whether the wings\n"
+        "                and coloring were needed, up to -v, -e, -i, -k, -y, -z, and -d, without search (default 0)\n"
+        "  -x 0|1        solve by exact cover instead (default 0)\n"
+        "  -m N          cache up to N megabytes of solve results, for repeated puzzles (default: none)\n",
+        Name);
+    exit(1);
+}
+
+
+// Output is collected and written in big pieces, instead of one call for each cell
+
+class OutputBuffer
+{
+    FILE *File;
+    string Data;
+
+public:
+    OutputBuffer(FILE *File_): File(File_) {Data.reserve(1 << 20);}
+    ~OutputBuffer() {Flush();}
+    
+    void Flush()
+    {
+        fwrite(Data.data(),1,Data.size(),File);
+        Data.clear();
+    }
+    void FlushIfFull() {if (Data.size() >= (1 << 20)) Flush();}
+    
+    void Add(char c) {Data.push_back(c);}
+    void Add(const char *Str) {Data.append(Str);}
+    void Add(uint Val)
+    {
+        char Digits[16];
+        int Len = 0;
+        do {
+            Digits[Len++] = (char)('0' + Val % 10);
+            Val /= 10;
+        } while (Val > 0);
+        while (Len > 0) Data.push_back(Digits[--Len]);
+    }
+    void AddFormatted(const char *Format, ...);
+};
+
+void OutputBuffer::AddFormatted(const char *Format, ...)
+{
+    char Buffer[256];
+    va_list Args;
+    va_start(Args,Format);
+    int Len = vsnprintf(Buffer,sizeof(Buffer),Format,Args);
+    va_end(Args);
+    if (Len > 0) Data.append(Buffer,min((size_t)Len,sizeof(Buffer)-1));
+}
+
+
+// A puzzle on its way through the pipeline. Its stamp says which puzzle it is for and which stage has it:
+// for puzzle ip, 3*ip when the parser may fill it, 3*ip+1 when a worker may solve it,
+// and 3*ip+2 when the writer may write it. The writer then makes it ready for puzzle ip + (number of slots).
+// So each stage waits only for its own puzzle. It spins for a little while,
+// then sleeps on the slot's condition variable until the stamp changes
+
+enum {SlotEmpty, SlotParsed, SlotSolved};
+
+struct PipelineSlot
+{
+    atomic<size_t> Stamp;
+    
+    // For the stages that have stopped spinning
+    mutex WaitLock;
+    condition_variable Changed;
+    atomic<uint> NumWaiting;
+    
+    Puzzle P;
+    vector<byte> Solved;
+    uint Count;         // Solutions found, if counting
+    SolverGrade Grade;  // If grading
+    double Time;        // Seconds
+#if SOLVER_STATS
+    vector<TechniqueStats> Stats;
+#endif
+    
+    PipelineSlot(): Stamp(0), NumWaiting(0), Count(0), Time(0) {}
+};
+
+// Waits a little for another stage; returns false when it is time to block instead
+inline bool Pause(uint &NumTries)
+{
+    if (++NumTries < 64) return true;
+    if (NumTries >= 128) return false;
+    this_thread::yield();
+    return true;
+}
+
+
+struct PipelineOptions
+{
+    SolverParameters Params;
+    PuzzleFormat Format, OutFormat;
+    bool IsJSON, IsConverting, IsGrading;
+    uint BlockRows, BlockCols;
+    uint MaxCount;
+    SolveCache *Cache;
+};
+
+class Pipeline
+{
+    PipelineOptions &Opts;
+    
+    // Slot i holds puzzles i, i + NumSlots, i + 2*NumSlots, ...
+    vector<PipelineSlot> Slots;
+    
+    // The number of puzzles, once the parser has finished
+    atomic<size_t> NumPuzzles;
+    atomic<bool> IsParsed;
+    // Stops all the stages early
+    atomic<bool> IsStopped;
+    atomic<size_t> NextToSolve;
+    
+    // The files, already open
+    vector<PuzzleMap *> &Inputs;
+    vector<const char *> &InputNames;
+    
+    atomic<bool> IsOK;
+    
+    PipelineSlot &Slot(size_t ip) {return Slots[ip % Slots.size()];}
+    
+    // Whether puzzle ip will never reach any later stage
+    bool IsDone(size_t ip)
+        {return IsStopped.load() || (IsParsed.load() && ip >= NumPuzzles.load());}
+    
+    // Waits for puzzle ip to reach that stage; returns false if there are no more or the pipeline stopped
+    bool WaitFor(size_t ip, uint Stage);
+    // Hands a slot to the next stage, waking it if it is asleep
+    void SetStamp(PipelineSlot &S, size_t Stamp);
+    // Wakes all the sleeping stages so that they can check IsDone()
+    void WakeAll();
+    void Stop();
+    
+    void Parse();
+    void Solve();
+    void Write();
+    
+    void WriteText(OutputBuffer &Out, PipelineSlot &S, const vector<byte> &Vals);
+    void WriteLine(OutputBuffer &Out, const vector<byte> &Vals);
+    void WriteJSON(OutputBuffer &Out, size_t ip, PipelineSlot &S);
+    void WriteStatus(OutputBuffer &Out, PipelineSlot &S, const vector<byte> &Vals);
+
+public:
+    Pipeline(PipelineOptions &Opts_, vector<PuzzleMap *> &Inputs_, vector<const char *> &InputNames_,
+             uint NumSlots);
+    
+    // Returns whether all the puzzles were read and written
+    bool Run(uint NumThreads);
+};
+
+
+Pipeline::Pipeline(PipelineOptions &Opts_, vector<PuzzleMap *> &Inputs_, vector<const char *> &InputNames_,
+                   uint NumSlots):
+    Opts(Opts_), Slots(NumSlots), NumPuzzles(0), IsParsed(false), IsStopped(false), NextToSolve(0),
+    Inputs(Inputs_), InputNames(InputNames_), IsOK(true)
+{
+    for (size_t is=0; is<Slots.size(); is++)
+        Slots[is].Stamp.store(3*is + SlotEmpty);
+}
+
+bool Pipeline::WaitFor(size_t ip, uint Stage)
+{
+    PipelineSlot &S = Slot(ip);
+    size_t Stamp = 3*ip + Stage;
+    uint NumTries = 0;
+    while (true)
+    {
+        if (S.Stamp.load() == Stamp) return true;
+        if (IsDone(ip)) return false;
+        if (!Pause(NumTries)) break;
+    }
+    
+    // Counted before checking the stamp again, so that SetStamp() either sees the count
+    // or else this sees the new stamp
+    unique_lock<mutex> Lock(S.WaitLock);
+    S.NumWaiting++;
+    while (S.Stamp.load() != Stamp && !IsDone(ip))
+        S.Changed.wait(Lock);
+    S.NumWaiting--;
+    return S.Stamp.load() == Stamp;
+}
+
+void Pipeline::SetStamp(PipelineSlot &S, size_t Stamp)
+{
+    S.Stamp.store(Stamp);
+    if (S.NumWaiting.load() == 0) return;
+    // Taking the lock keeps the wakeup from arriving between a waiter's check and its wait
+    lock_guard<mutex> Lock(S.WaitLock);
+    S.Changed.notify_all();
+}
+
+void Pipeline::WakeAll()
+{
+    for (size_t is=0; is<Slots.size(); is++)
+    {
+        PipelineSlot &S = Slots[is];
+        lock_guard<mutex> Lock(S.WaitLock);
+        S.Changed.notify_all();
+    }
+}
+
+void Pipeline::Stop()
+{
+    IsStopped.store(true);
+    WakeAll();
+}
+
+void Pipeline::Parse()
+{
+    size_t ip = 0;
+    for (size_t ifile=0; ifile<Inputs.size() && IsOK; ifile++)
+    {
+        PuzzleMap &Contents = *Inputs[ifile];
+        PuzzleScanner Scanner(Contents.Begin(),Contents.End(),Opts.Format,Opts.BlockRows,Opts.BlockCols);
+        while (true)
+        {
+            // Wait for the writer to be done with the slot's previous puzzle
+            if (!WaitFor(ip,SlotEmpty)) break;
+            PipelineSlot &S = Slot(ip);
+            if (!Scanner.Next(S.P)) break;
+            SetStamp(S,3*ip + SlotParsed);
+            ip++;
+        }
+        if (Scanner.HasError())
+        {
+            fprintf(stderr,"%s: %s\n",InputNames[ifile],Scanner.GetError().c_str());
+            IsOK = false;
+        }
+    }
+    
+    NumPuzzles.store(ip);
+    IsParsed.store(true);
+    WakeAll();
+}
+
+void Pipeline::Solve()
+{
+    // Reused while the puzzles keep the same block dimensions
+    BoardManager *BM = NULL;
+    while (true)
+    {
+        size_t ip = NextToSolve++;
+        if (!WaitFor(ip,SlotParsed)) break;
+        PipelineSlot &S = Slot(ip);
+        Puzzle &P = S.P;
+        
+        if (!Opts.IsConverting)
+        {
+            chrono::steady_clock::time_point StartTime = chrono::steady_clock::now();
+            
+            if (BM == NULL || BM->GetBlockRows() != P.BlockRows || BM->GetBlockCols() != P.BlockCols)
+            {
+                delete BM;
+                BM = new BoardManager(P.BlockRows,P.BlockCols,Opts.Params);
+                BM->SetCache(Opts.Cache);
+            }
+#if SOLVER_STATS
+            if (Opts.IsJSON) BM->ClearStats();
+#endif
+            BM->SetValues(&P.Vals[0]);
+            if (Opts.IsGrading)
+                BM->Grade(S.Grade);
+            else if (Opts.MaxCount > 0)
+                S.Count = BM->CountSolutions(Opts.MaxCount);
+            else
+                BM->SolveAndUpdate();
+            S.Solved.resize(P.Vals.size());
+            BM->GetValues(&S.Solved[0]);
+            
+            chrono::duration<double> Elapsed = chrono::steady_clock::now() - StartTime;
+            S.Time = Elapsed.count();
+#if SOLVER_STATS
+            if (Opts.IsJSON) BM->GetStats(S.Stats);
+#endif
+        }
+        
+        SetStamp(S,3*ip + SlotSolved);
+    }
+    delete BM;
+}
+
+
+// As the app writes its files
+void Pipeline::WriteText(OutputBuffer &Out, PipelineSlot &S, const vector<byte> &Vals)
+{
+    uint SideLength = S.P.BlockRows*S.P.BlockCols;
+    Out.Add(S.P.BlockRows);
+    Out.Add('\t');
+    Out.Add(S.P.BlockCols);
+    Out.Add('\n');
+    for (uint irow=0; irow<SideLength; irow++)
+    {
+        for (uint icol=0; icol<SideLength; icol++)
+        {
+            Out.Add((uint)Vals[SideLength*irow+icol]);
+            Out.Add('\t');
+        }
+        Out.Add('\n');
+    }
+}
+
+void Pipeline::WriteLine(OutputBuffer &Out, const vector<byte> &Vals)
+{
+    for (uint ic=0; ic<Vals.size(); ic++)
+        Out.Add(PuzzleValueToChar(Vals[ic]));
+}
+
+// The solution count or whether it was solved, with the grade if grading, then the time
+void Pipeline::WriteStatus(OutputBuffer &Out, PipelineSlot &S, const vector<byte> &Vals)
+{
+    if (Opts.IsGrading)
+        Out.AddFormatted("%s\tgrade vis %u hid %u itsc %u fish %u xy %u xyz %u color %u",
+                         S.Grade.IsSolved ? "solved" : "unsolved",
+                         S.Grade.VisibleSetSize,S.Grade.HiddenSetSize,S.Grade.UsedIntersections ? 1 : 0,
+                         S.Grade.FishSize,S.Grade.UsedXYWing ? 1 : 0,S.Grade.UsedXYZWing ? 1 : 0,
+                         S.Grade.UsedColoring ? 1 : 0);
+    else if (Opts.MaxCount > 0)
+        Out.AddFormatted("count %u%s",S.Count,(S.Count >= Opts.MaxCount) ? "+" : "");
+    else
+        Out.Add((memchr(&Vals[0],0,Vals.size()) == NULL) ? "solved" : "unsolved");
+    Out.AddFormatted("\t%.1f us",1e6*S.Time);
+}
+
+// One object per line. The values are arrays of numbers, since the line format's characters
+// do not go up to the biggest side lengths
+void Pipeline::WriteJSON(OutputBuffer &Out, size_t ip, PipelineSlot &S)
+{
+    Out.AddFormatted("{\"puzzle\": %zu, \"block_rows\": %u, \"block_cols\": %u, \"givens\": [",
+                     ip+1,S.P.BlockRows,S.P.BlockCols);
+    uint NumGivens = 0;
+    for (uint ic=0; ic<S.P.Vals.size(); ic++)
+    {
+        if (ic > 0) Out.Add(',');
+        Out.Add((uint)S.P.Vals[ic]);
+        if (S.P.Vals[ic] != 0) NumGivens++;
+    }
+    Out.Add(']');
+    
+    if (!Opts.IsConverting)
+    {
+        Out.Add(", \"values\": [");
+        uint NumFilled = 0;
+        for (uint ic=0; ic<S.Solved.size(); ic++)
+        {
+            if (ic > 0) Out.Add(',');
+            Out.Add((uint)S.Solved[ic]);
+            if (S.Solved[ic] != 0) NumFilled++;
+        }
+        Out.AddFormatted("], \"num_givens\": %u, \"num_filled\": %u, \"solved\": %s",
+                         NumGivens,NumFilled,(NumFilled == S.Solved.size()) ? "true" : "false");
+        if (Opts.IsGrading)
+            Out.AddFormatted(", \"grade\": {\"visible_set_size\": %u, \"hidden_set_size\": %u, "
+                             "\"intersections\": %s, \"fish_size\": %u, "
+                             "\"xy_wing\": %s, \"xyz_wing\": %s, \"coloring\": %s}",
+                             S.Grade.VisibleSetSize,S.Grade.HiddenSetSize,
+                             S.Grade.UsedIntersections ? "true" : "false",S.Grade.FishSize,
+                             S.Grade.UsedXYWing ? "true" : "false",S.Grade.UsedXYZWing ? "true" : "false",
+                             S.Grade.UsedColoring ? "true" : "false");
+        else if (Opts.MaxCount > 0)
+            Out.AddFormatted(", \"count\": %u, \"count_capped\": %s",
+                             S.Count,(S.Count >= Opts.MaxCount) ? "true" : "false");
+        Out.AddFormatted(", \"time_us\": %.1f",1e6*S.Time);
+#if SOLVER_STATS
+        // Only the ones that ran; none if it came from the cache
+        Out.Add(", \"techniques\": [");
+        bool IsFirstTech = true;
+        for (size_t it=0; it<S.Stats.size(); it++)
+        {
+            TechniqueStats &TS = S.Stats[it];
+            if (TS.Invocations == 0) continue;
+            Out.AddFormatted("%s{\"name\": \"%s\", \"invocations\": %llu, \"productive\": %llu, "
+                             "\"eliminated\": %llu}",
+                             IsFirstTech ? "" : ", ",TS.Name.c_str(),TS.Invocations,TS.Productive,
+                             TS.Eliminated);
+            IsFirstTech = false;
+        }
+        Out.Add(']');
+#endif
+    }
+    Out.Add("}\n");
+}
+
+// In input order
+void Pipeline::Write()
+{
+    OutputBuffer Out(stdout), Err(stderr);
+    PuzzleBinaryWriter *Writer = NULL;
+    bool IsSolved = !Opts.IsConverting;
+    
+    size_t ip;
+    for (ip=0; WaitFor(ip,SlotSolved); ip++)
+    {
+        PipelineSlot &S = Slot(ip);
+        const vector<byte> &Vals = IsSolved ? S.Solved : S.P.Vals;
+        
+        if (Opts.IsJSON)
+            WriteJSON(Out,ip,S);
+        else if (Opts.OutFormat == PuzzleFormatLine)
+        {
+            if (S.P.BlockRows*S.P.BlockCols > MaxLineValue)
+            {
+                fprintf(stderr,"Line output needs all the puzzles to have side lengths of at most %u\n",MaxLineValue);
+                IsOK = false;
+                Stop();
+                break;
+            }
+            WriteLine(Out,Vals);
+            if (IsSolved)
+            {
+                Out.Add('\t');
+                WriteStatus(Out,S,Vals);
+            }
+            Out.Add('\n');
+        }
+        else
+        {
+            // With the status and time going to standard error
+            if (Opts.OutFormat == PuzzleFormatBinary)
+            {
+                // One container has one block size
+                if (Writer == NULL)
+                    Writer = new PuzzleBinaryWriter(stdout,S.P.BlockRows,S.P.BlockCols);
+                else if (Writer->GetBlockRows() != S.P.BlockRows || Writer->GetBlockCols() != S.P.BlockCols)
+                {
+                    fprintf(stderr,"Binary output needs all the puzzles to have the same block dimensions\n");
+                    IsOK = false;
+                    Stop();
+                    break;
+                }
+                Writer->Write(&S.P.Vals[0],IsSolved ? &S.Solved[0] : NULL);
+            }
+            else
+                WriteText(Out,S,Vals);
+            
+            if (IsSolved)
+            {
+                Err.AddFormatted("%zu\t",ip+1);
+                WriteStatus(Err,S,Vals);
+                Err.Add('\n');
+                Err.FlushIfFull();
+            }
+        }
+        Out.FlushIfFull();
+        
+        SetStamp(S,3*(ip + Slots.size()) + SlotEmpty);
+    }
+    
+    if (Writer != NULL)
+    {
+        if (!Writer->Finish())
+        {
+            perror("Writing the binary output");
+            IsOK = false;
+        }
+        delete Writer;
+    }
+}
+
+
+bool Pipeline::Run(uint NumThreads)
+{
+    thread Parser(&Pipeline::Parse,this);
+    vector<thread> Workers;
+    for (uint it=0; it<NumThreads; it++)
+        Workers.push_back(thread(&Pipeline::Solve,this));
+    Write();
+    
+    Parser.join();
+    for (uint it=0; it<NumThreads; it++)
+        Workers[it].join();
+    return IsOK;
+}
+
+
+int main(int argc, char *argv[])
+{
+    PipelineOptions Opts;
+    Opts.Format = PuzzleFormatAuto;
+    Opts.OutFormat = PuzzleFormatAuto;
+    Opts.IsJSON = false;
+    Opts.IsConverting = false;
+    Opts.IsGrading = false;
+    Opts.BlockRows = Opts.BlockCols = 0;
+    Opts.MaxCount = 0;
+    Opts.Cache = NULL;
+    SolverParameters &Params = Opts.Params;
+    uint NumThreads = thread::hardware_concurrency();
+    uint NumSlots = 1024;
+    uint CacheMegabytes = 0;
+    
+    int iarg;
+    for (iarg=1; iarg<argc; iarg++)
+    {
+        const char *Arg = argv[iarg];
+        if (Arg[0] != '-' || Arg[1] == 0) break;
+        if (strcmp(Arg,"--") == 0) {iarg++; break;}
+        if (Arg[2] != 0 || iarg+1 >= argc) Usage(argv[0]);
+        const char *Val = argv[++iarg];
+        switch(Arg[1])
+        {
+        case 'f':
+        case 'o':
+        {
+            PuzzleFormat &Which = (Arg[1] == 'f') ? Opts.Format : Opts.OutFormat;
+            if (strcmp(Val,"text") == 0) Which = PuzzleFormatText;
+            else if (strcmp(Val,"line") == 0) Which = PuzzleFormatLine;
+            else if (strcmp(Val,"binary") == 0) Which = PuzzleFormatBinary;
+            else if (Arg[1] == 'o' && strcmp(Val,"json") == 0) Opts.IsJSON = true;
+            else Usage(argv[0]);
+            break;
+        }
+        case 'n': Opts.IsConverting = (atoi(Val) != 0); break;
+        case 'b':
+            if (sscanf(Val,"%ux%u",&Opts.BlockRows,&Opts.BlockCols) != 2 ||
+                Opts.BlockRows < 1 || Opts.BlockRows > MaxBlockSize ||
+                Opts.BlockCols < 1 || Opts.BlockCols > MaxBlockSize)
+                Usage(argv[0]);
+            break;
+        case 'j': NumThreads = (uint)atoi(Val); break;
+        case 'q': NumSlots = (uint)atoi(Val); break;
+        case 'v': Params.MaxVisibleSetSize = (uint)atoi(Val); break;
+        case 'e': Params.MaxHiddenSetSize = (uint)atoi(Val); break;
+        case 'i': Params.UseIntersections = (atoi(Val) != 0); break;
+        case 'k': Params.MaxFishSize = (uint)atoi(Val); break;
+        case 'y': Params.UseXYWing = (atoi(Val) != 0); break;
+        case 'z': Params.UseXYZWing = (atoi(Val) != 0); break;
+        case 'd': Params.UseColoring = (atoi(Val) != 0); break;
+        case 's': Params.UseSearch = true; Params.SearchSetSize = (uint)atoi(Val); break;
+        case 'p': Params.SearchThreads = (uint)atoi(Val); break;
+        case 'c': Opts.MaxCount = (uint)atoi(Val); break;
+        case 'g': Opts.IsGrading = (atoi(Val) != 0); break;
+        case 'x': Params.UseExactCover = (atoi(Val) != 0); break;
+        case 'm': CacheMegabytes = (uint)atoi(Val); break;
+        default: Usage(argv[0]);
+        }
+    }
+    if (NumThreads < 1) NumThreads = 1;
+    if (NumSlots < 1) NumSlots = 1;
+    
+    // Open all the files, which maps them without reading them
+    vector<PuzzleMap *> Inputs;
+    vector<const char *> InputNames;
+    for (int ifile=iarg; ifile<=argc; ifile++)
+    {
+        const char *FileName;
+        PuzzleMap *Contents = new PuzzleMap;
+        string Error;
+        bool IsOK;
+        if (ifile == argc)
+        {
+            // Standard input if no files
+            if (iarg < argc) {delete Contents; break;}
+            FileName = "(stdin)";
+            IsOK = Contents->Read(stdin,Error);
+        }
+        else
+        {
+            FileName = argv[ifile];
+            IsOK = Contents->Open(FileName,Error);
+        }
+        if (!IsOK)
+        {
+            fprintf(stderr,"%s: %s\n",FileName,Error.c_str());
+            return 1;
+        }
+        Inputs.push_back(Contents);
+        InputNames.push_back(FileName);
+    }
+    
+    // Output in the first file's format if none is given
+    if (Opts.OutFormat == PuzzleFormatAuto)
+        Opts.OutFormat = (Opts.Format != PuzzleFormatAuto) ? Opts.Format :
+            GuessPuzzleFormat(Inputs[0]->Begin(),Inputs[0]->End());
+    
+    if (CacheMegabytes > 0) Opts.Cache = new SolveCache((size_t)CacheMegabytes << 20);
+    
+    Pipeline Pipe(Opts,Inputs,InputNames,NumSlots);
+    bool IsOK = Pipe.Run(NumThreads);
+    
+    if (Opts.Cache != NULL)
+    {
+        SolveCacheCounts Counts = Opts.Cache->GetCounts();
+        fprintf(stderr,"cache: %llu hits, %llu misses, %llu evictions, %zu results in %zu bytes\n",
+                Counts.Hits,Counts.Misses,Counts.Evictions,Counts.Entries,Counts.Bytes);
+        delete Opts.Cache;
+    }
+    for (size_t ifile=0; ifile<Inputs.size(); ifile++)
+        delete Inputs[ifile];
+    
+    return IsOK ? 0 : 1;
+}
@@ -0,0 +1,322 @@
+//
+//  main.cpp
+//  Benchmark
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// End-to-end benchmark: runs BoardManager::SolveAndUpdate() over puzzle files
+// under each of several solver presets, and writes puzzles per second,
+// per-puzzle latency percentiles, and the fraction of puzzles fully solved, as JSON.
+// It runs on one thread, so that the latencies are not disturbed by other work.
+// Built with SOLVER_STATS defined as 1, it also writes each technique's statistics.
+//
+// The bundled corpus is in Corpus/, in the app's file format.
+//
+
+#include "BoardManager.hpp"
+#include "SolverParameters.h"
+#include "PuzzleReader.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+using namespace std;
+
+
+struct Preset
+{
+    const char *Name;
+    SolverParameters Params;
+    // Bigger puzzles are skipped
+    uint MaxSideLength;
+};
+
+static vector<Preset> GetPresets()
+{
+    vector<Preset> Presets;
+    Preset P;
+    P.MaxSideLength = 25;
+    
+    // Naked and hidden singles only
+    P.Name = "singles";
+    P.Params = SolverParameters();
+    P.Params.MaxVisibleSetSize = 1;
+    P.Params.MaxHiddenSetSize = 1;
+    P.Params.UseIntersections = false;
+    P.Params.MaxFishSize = 0;
+    P.Params.UseXYWing = P.Params.UseXYZWing = P.Params.UseColoring = false;
+    Presets.push_back(P);
+    
+    // Small sets and intersections
+    P.Name = "sets";
+    P.Params = SolverParameters();
+    P.Params.MaxVisibleSetSize = 3;
+    P.Params.MaxHiddenSetSize = 3;
+    P.Params.MaxFishSize = 0;
+    P.Params.UseXYWing = P.Params.UseXYZWing = P.Params.UseColoring = false;
+    Presets.push_back(P);
+    
+    // The app's defaults
+    P.Name = "full";
+    P.Params = SolverParameters();
+    Presets.push_back(P);
+    
+    // The defaults, then search if they stall
+    P.Name = "search";
+    P.Params = SolverParameters();
+    P.Params.UseSearch = true;
+    Presets.push_back(P);
+    
+    // Plain dancing links can take minutes or more on sparse 25*25 puzzles,
+    // since it cannot make the deductions that the techniques do
+    P.Name = "exact-cover";
+    P.Params = SolverParameters();
+    P.Params.UseExactCover = true;
+    P.MaxSideLength = 16;
+    Presets.push_back(P);
+    
+    return Presets;
+}
+
+
+static void Usage(const char *Name)
+{
+    fprintf(stderr,
+        "Usage: %s [options] file ...\n"
+        "  -p name,...   presets to run (default: all of them):\n"
+        "                singles, sets, full, search, exact-cover\n"
+        "  -r N          solve each puzzle N times (default 1)\n"
+        "  -o file       write the JSON there (default: standard output)\n",
+        Name);
+    exit(1);
+}
+
+
+struct RunResult
+{
+    size_t NumPuzzles, NumSolved, NumSkipped;
+    double TotalTime;           // Seconds
+    vector<double> Latencies;   // Seconds, sorted
+    vector<TechniqueStats> Techniques;
+};
+
+// Adds a board manager's technique statistics to the run's, matching them by name,
+// since boards of different sizes have different numbers of set sizes
+static void AddStats(BoardManager *BM, vector<TechniqueStats> &Total)
+{
+    if (BM == NULL) return;
+    vector<TechniqueStats> Stats;
+    BM->GetStats(Stats);
+    for (size_t is=0; is<Stats.size(); is++)
+    {
+        size_t it;
+        for (it=0; it<Total.size(); it++)
+            if (Total[it].Name == Stats[is].Name) break;
+        if (it >= Total.size())
+        {
+            Total.push_back(Stats[is]);
+            continue;
+        }
+        Total[it].Invocations += Stats[is].Invocations;
+        Total[it].Productive += Stats[is].Productive;
+        Total[it].Eliminated += Stats[is].Eliminated;
+        Total[it].Time += Stats[is].Time;
+    }
+}
+
+static void RunPreset(vector<Puzzle> &Puzzles, Preset &Pst, uint NumRepeats, RunResult &Result)
+{
+    Result.NumPuzzles = Result.NumSolved = Result.NumSkipped = 0;
+    Result.TotalTime = 0;
+    Result.Latencies.clear();
+    Result.Techniques.clear();
+    
+    // Reused while the puzzles keep the same block dimensions
+    BoardManager *BM = NULL;
+    for (size_t ip=0; ip<Puzzles.size(); ip++)
+    {
+        Puzzle &P = Puzzles[ip];
+        uint SideLength = P.BlockRows*P.BlockCols;
+        if (SideLength > Pst.MaxSideLength)
+        {
+            Result.NumSkipped++;
+            continue;
+        }
+        if (BM == NULL || BM->GetBlockRows() != P.BlockRows || BM->GetBlockCols() != P.BlockCols)
+        {
+            AddStats(BM,Result.Techniques);
+            delete BM;
+            BM = new BoardManager(P.BlockRows,P.BlockCols,Pst.Params);
+        }
+        
+        bool IsSolved = true;
+        for (uint irpt=0; irpt<NumRepeats; irpt++)
+        {
+            for (uint irow=0; irow<SideLength; irow++)
+                for (uint icol=0; icol<SideLength; icol++)
+                    BM->Value(irow,icol) = P.Vals[SideLength*irow+icol];
+            
+            chrono::steady_clock::time_point StartTime = chrono::steady_clock::now();
+            BM->SolveAndUpdate();
+            chrono::duration<double> Elapsed = chrono::steady_clock::now() - StartTime;
+            Result.Latencies.push_back(Elapsed.count());
+            Result.TotalTime += Elapsed.count();
+            
+            for (uint irow=0; irow<SideLength; irow++)
+                for (uint icol=0; icol<SideLength; icol++)
+                    if (BM->Value(irow,icol) == 0) IsSolved = false;
+        }
+        Result.NumPuzzles++;
+        if (IsSolved) Result.NumSolved++;
+    }
+    AddStats(BM,Result.Techniques);
+    delete BM;
+    
+    sort(Result.Latencies.begin(),Result.Latencies.end());
+}
+
+
+// Nearest rank, in microseconds
+static double Percentile(vector<double> &Sorted, double Fraction)
+{
+    if (Sorted.empty()) return 0;
+    size_t Rank = (size_t)ceil(Fraction*Sorted.size());
+    if (Rank < 1) Rank = 1;
+    return 1e6*Sorted[Rank-1];
+}
+
+// The name without the directory, with JSON's special characters escaped
+static string JSONFileName(const char *Path)
+{
+    const char *Name = strrchr(Path,'/');
+    Name = (Name != NULL) ? Name+1 : Path;
+    string Escaped;
+    for (const char *c=Name; *c!=0; c++)
+    {
+        if (*c == '"' || *c == '\\') Escaped.push_back('\\');
+        if ((unsigned char)*c >= ' ') Escaped.push_back(*c);
+    }
+    return Escaped;
+}
+
+
+int main(int argc, char *argv[])
+{
+    vector<Preset> AllPresets = GetPresets();
+    vector<Preset> Presets;
+    uint NumRepeats = 1;
+    const char *OutName = NULL;
+    
+    int iarg;
+    for (iarg=1; iarg<argc; iarg++)
+    {
+        const char *Arg = argv[iarg];
+        if (Arg[0] != '-' || Arg[1] == 0) break;
+        if (strcmp(Arg,"--") == 0) {iarg++; break;}
+        if (Arg[2] != 0 || iarg+1 >= argc) Usage(argv[0]);
+        const char *Val = argv[++iarg];
+        switch(Arg[1])
+        {
+        case 'p':
+            {
+                string Names = Val;
+                size_t Start = 0;
+                while (Start <= Names.size())
+                {
+                    size_t End = Names.find(',',Start);
+                    if (End == string::npos) End = Names.size();
+                    string Name = Names.substr(Start,End-Start);
+                    size_t ipst;
+                    for (ipst=0; ipst<AllPresets.size(); ipst++)
+                        if (Name == AllPresets[ipst].Name) break;
+                    if (ipst >= AllPresets.size()) Usage(argv[0]);
+                    Presets.push_back(AllPresets[ipst]);
+                    Start = End + 1;
+                }
+            }
+            break;
+        case 'r': NumRepeats = (uint)atoi(Val); break;
+        case 'o': OutName = Val; break;
+        default: Usage(argv[0]);
+        }
+    }
+    if (iarg >= argc) Usage(argv[0]);
+    if (NumRepeats < 1) NumRepeats = 1;
+    if (Presets.empty()) Presets = AllPresets;
+    
+    FILE *Out = stdout;
+    if (OutName != NULL)
+    {
+        Out = fopen(OutName,"w");
+        if (Out == NULL)
+        {
+            perror(OutName);
+            return 1;
+        }
+    }
+    
+    fprintf(Out,"{\n  \"repeats\": %u,\n  \"results\": [",NumRepeats);
+    bool IsFirst = true;
+    for (int ifile=iarg; ifile<argc; ifile++)
+    {
+        const char *FileName = argv[ifile];
+        PuzzleMap Contents;
+        vector<Puzzle> Puzzles;
+        string Error;
+        bool IsOK = Contents.Open(FileName,Error) &&
+            ReadPuzzles(Contents.Begin(),Contents.End(),PuzzleFormatAuto,0,0,Puzzles,Error);
+        if (!IsOK)
+        {
+            fprintf(stderr,"%s: %s\n",FileName,Error.c_str());
+            return 1;
+        }
+        
+        for (size_t ipst=0; ipst<Presets.size(); ipst++)
+        {
+            Preset &Pst = Presets[ipst];
+            RunResult Result;
+            RunPreset(Puzzles,Pst,NumRepeats,Result);
+            
+            // Progress, since a whole run can take a while
+            fprintf(stderr,"%s %s: %zu/%zu solved, %.3f s\n",JSONFileName(FileName).c_str(),Pst.Name,
+                    Result.NumSolved,Result.NumPuzzles,Result.TotalTime);
+            
+            fprintf(Out,"%s\n    {\"corpus\": \"%s\", \"preset\": \"%s\",\n",
+                    IsFirst ? "" : ",",JSONFileName(FileName).c_str(),Pst.Name);
+            fprintf(Out,"     \"puzzles\": %zu, \"skipped\": %zu, \"solved\": %zu, \"fraction_solved\": %.4f,\n",
+                    Result.NumPuzzles,Result.NumSkipped,Result.NumSolved,
+                    (Result.NumPuzzles > 0) ? (double)Result.NumSolved/Result.NumPuzzles : 0.);
+            fprintf(Out,"     \"seconds\": %.6f, \"puzzles_per_sec\": %.1f,\n",Result.TotalTime,
+                    (Result.TotalTime > 0) ? Result.Latencies.size()/Result.TotalTime : 0.);
+            fprintf(Out,"     \"latency_us\": {\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"max\": %.1f}",
+                    Percentile(Result.Latencies,0.5),Percentile(Result.Latencies,0.9),
+                    Percentile(Result.Latencies,0.99),Percentile(Result.Latencies,1));
+            if (!Result.Techniques.empty())
+            {
+                // Only the ones that ran, since most set sizes do not with the presets
+                fprintf(Out,",\n     \"techniques\": [");
+                bool IsFirstTech = true;
+                for (size_t it=0; it<Result.Techniques.size(); it++)
+                {
+                    TechniqueStats &TS = Result.Techniques[it];
+                    if (TS.Invocations == 0) continue;
+                    fprintf(Out,"%s\n       {\"name\": \"%s\", \"invocations\": %llu, \"productive\": %llu, "
+                            "\"eliminated\": %llu, \"seconds\": %.6f}",
+                            IsFirstTech ? "" : ",",TS.Name.c_str(),TS.Invocations,TS.Productive,
+                            TS.Eliminated,TS.Time);
+                    IsFirstTech = false;
+                }
+                fprintf(Out,"]");
+            }
+            fprintf(Out,"}");
+            IsFirst = false;
+        }
+    }
+    fprintf(Out,"\n  ]\n}\n");
+    
+    if (Out != stdout) fclose(Out);
+    return 0;
+}
@@ -0,0 +1,225 @@
+//
+//  main.cpp
+//  Puzzle Generator
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Command-line puzzle generator: makes puzzles with unique solutions,
+// optionally only ones that the solution techniques can solve with some parameters,
+// and writes them in a format that PuzzleReader reads.
+// Puzzles are made across a pool of worker threads, each with its own generator,
+// and each puzzle's removals can also be tried across threads.
+// Puzzle k is made from seed + k, so the output depends only on the seed, not on the threads.
+//
+
+#include "PuzzleGenerator.hpp"
+#include "SolverParameters.h"
+#include "PuzzleReader.hpp"
+#include "PuzzleBinary.hpp"
+#include "SudokuConstants.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+using namespace std;
+
+
+static void Usage(const char *Name)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "Writes the puzzles to standard output\n"
+        "  -b RxC        block dimensions (default 3x3)\n"
+        "  -n N          number of puzzles (default 1)\n"
+        "  -t N          random seed (default: from the time)\n"
+        "  -o text|line|binary  output format (default line);\n"
+        "                binary also has each puzzle's solution\n"
+        "  -j N          number of worker threads, each making its own puzzles (default: all of them)\n"
+        "  -r N          number of threads for trying each puzzle's removals (default 1)\n"
+        "  -s N          limit on each removal check's search nodes, 0 for none, which makes minimal puzzles\n"
+        "                (default %zu)\n"
+        "  -l 0|1        require that the techniques solve the puzzles, without search (default 0)\n"
+        "  -v N          maximum visible-set size for that (default 5)\n"
+        "  -e N          maximum hidden-set size for that (default 5)\n"
+        "  -i 0|1        use intersections for that (default 1)\n"
+        "  -k N          maximum fish size for that, 0 for none (default 4)\n"
+        "  -y 0|1        use XY-Wings for that (default 1)\n"
+        "  -z 0|1        use XYZ-Wings for that (default 1)\n"
+        "  -d 0|1        use single-digit coloring for that (default 1)\n",
+        Name,(size_t)PuzzleGenerator::DefaultMaxSearchNodes);
+    exit(1);
+}
+
+
+struct GeneratorOptions
+{
+    uint BlockRows, BlockCols;
+    uint64_t Seed;
+    bool IsRequired;
+    SolverParameters Params;
+    uint RemovalThreads;
+    bool HasMaxSearchNodes;
+    size_t MaxSearchNodes;
+};
+
+// Workers put puzzles here, and the main thread writes them in order
+struct GeneratedPuzzles
+{
+    vector<vector<byte> > Vals, Solutions;
+    vector<char> IsDone;
+    atomic<size_t> Next;
+    mutex Lock;
+    condition_variable Done;
+    
+    GeneratedPuzzles(size_t NumPuzzles):
+        Vals(NumPuzzles), Solutions(NumPuzzles), IsDone(NumPuzzles,0), Next(0) {}
+};
+
+static void Generate(GeneratorOptions &Opts, GeneratedPuzzles &Puzzles)
+{
+    PuzzleGenerator Generator(Opts.BlockRows,Opts.BlockCols,Opts.Seed);
+    if (Opts.IsRequired) Generator.SetRequired(Opts.Params);
+    Generator.SetRemovalThreads(Opts.RemovalThreads);
+    if (Opts.HasMaxSearchNodes) Generator.SetMaxSearchNodes(Opts.MaxSearchNodes);
+    uint BoardSize = Generator.GetBoardSize();
+    
+    while (true)
+    {
+        size_t ip = Puzzles.Next++;
+        if (ip >= Puzzles.Vals.size()) break;
+        
+        vector<byte> Vals(BoardSize), Solution(BoardSize);
+        Generator.SetSeed(Opts.Seed + ip);
+        Generator.Generate(&Vals[0],&Solution[0]);
+        
+        lock_guard<mutex> Guard(Puzzles.Lock);
+        Puzzles.Vals[ip].swap(Vals);
+        Puzzles.Solutions[ip].swap(Solution);
+        Puzzles.IsDone[ip] = 1;
+        Puzzles.Done.notify_all();
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    GeneratorOptions Opts;
+    Opts.BlockRows = Opts.BlockCols = 3;
+    Opts.Seed = (uint64_t)chrono::system_clock::now().time_since_epoch().count();
+    Opts.IsRequired = false;
+    Opts.RemovalThreads = 1;
+    Opts.HasMaxSearchNodes = false;
+    Opts.MaxSearchNodes = 0;
+    SolverParameters &Params = Opts.Params;
+    PuzzleFormat Format = PuzzleFormatLine;
+    size_t NumPuzzles = 1;
+    uint NumThreads = thread::hardware_concurrency();
+    
+    for (int iarg=1; iarg<argc; iarg++)
+    {
+        const char *Arg = argv[iarg];
+        if (Arg[0] != '-' || Arg[1] == 0 || Arg[2] != 0 || iarg+1 >= argc) Usage(argv[0]);
+        const char *Val = argv[++iarg];
+        switch(Arg[1])
+        {
+        case 'b':
+            if (sscanf(Val,"%ux%u",&Opts.BlockRows,&Opts.BlockCols) != 2 ||
+                Opts.BlockRows < MinBlockSize || Opts.BlockRows > MaxBlockSize ||
+                Opts.BlockCols < MinBlockSize || Opts.BlockCols > MaxBlockSize)
+                Usage(argv[0]);
+            break;
+        case 'n': NumPuzzles = (size_t)atol(Val); break;
+        case 't': Opts.Seed = (uint64_t)strtoull(Val,NULL,10); break;
+        case 'o':
+            if (strcmp(Val,"text") == 0) Format = PuzzleFormatText;
+            else if (strcmp(Val,"line") == 0) Format = PuzzleFormatLine;
+            else if (strcmp(Val,"binary") == 0) Format = PuzzleFormatBinary;
+            else Usage(argv[0]);
+            break;
+        case 'j': NumThreads = (uint)atoi(Val); break;
+        case 'r': Opts.RemovalThreads = (uint)atoi(Val); break;
+        case 's': Opts.HasMaxSearchNodes = true; Opts.MaxSearchNodes = (size_t)atol(Val); break;
+        case 'l': Opts.IsRequired = (atoi(Val) != 0); break;
+        case 'v': Params.MaxVisibleSetSize = (uint)atoi(Val); break;
+        case 'e': Params.MaxHiddenSetSize = (uint)atoi(Val); break;
+        case 'i': Params.UseIntersections = (atoi(Val) != 0); break;
+        case 'k': Params.MaxFishSize = (uint)atoi(Val); break;
+        case 'y': Params.UseXYWing = (atoi(Val) != 0); break;
+        case 'z': Params.UseXYZWing = (atoi(Val) != 0); break;
+        case 'd': Params.UseColoring = (atoi(Val) != 0); break;
+        default: Usage(argv[0]);
+        }
+    }
+    if (NumThreads < 1) NumThreads = 1;
+    if (NumThreads > NumPuzzles) NumThreads = (uint)max(NumPuzzles,(size_t)1);
+    if (Opts.RemovalThreads < 1) Opts.RemovalThreads = 1;
+    if (Format == PuzzleFormatLine && Opts.BlockRows*Opts.BlockCols > MaxLineValue)
+    {
+        fprintf(stderr,"%s: the line format has side lengths of at most %u\n",argv[0],MaxLineValue);
+        return 1;
+    }
+    
+    GeneratedPuzzles Puzzles(NumPuzzles);
+    vector<thread> Workers;
+    for (uint it=0; it<NumThreads; it++)
+        Workers.push_back(thread(Generate,ref(Opts),ref(Puzzles)));
+    
+    // Write each one as soon as it and all the ones before it are done
+    uint SideLength = Opts.BlockRows*Opts.BlockCols;
+    PuzzleBinaryWriter *Binary = NULL;
+    if (Format == PuzzleFormatBinary) Binary = new PuzzleBinaryWriter(stdout,Opts.BlockRows,Opts.BlockCols);
+    string Out;
+    for (size_t ip=0; ip<NumPuzzles; ip++)
+    {
+        vector<byte> Vals, Solution;
+        {
+            unique_lock<mutex> Guard(Puzzles.Lock);
+            while (!Puzzles.IsDone[ip]) Puzzles.Done.wait(Guard);
+            Vals.swap(Puzzles.Vals[ip]);
+            Solution.swap(Puzzles.Solutions[ip]);
+        }
+        
+        if (Binary != NULL)
+        {
+            Binary->Write(&Vals[0],&Solution[0]);
+            continue;
+        }
+        Out.clear();
+        if (Format == PuzzleFormatText)
+        {
+            Out += to_string(Opts.BlockRows) + "\t" + to_string(Opts.BlockCols) + "\n";
+            for (uint irow=0; irow<SideLength; irow++)
+            {
+                for (uint icol=0; icol<SideLength; icol++)
+                    Out += to_string((uint)Vals[SideLength*irow+icol]) + "\t";
+                Out += '\n';
+            }
+        }
+        else
+        {
+            for (size_t ic=0; ic<Vals.size(); ic++)
+                Out += PuzzleValueToChar(Vals[ic]);
+            Out += '\n';
+        }
+        fwrite(Out.data(),1,Out.size(),stdout);
+    }
+    
+    for (uint it=0; it<NumThreads; it++)
+        Workers[it].join();
+    
+    bool IsOK = true;
+    if (Binary != NULL)
+    {
+        IsOK = Binary->Finish();
+        delete Binary;
+    }
+    if (fflush(stdout) != 0 || ferror(stdout)) IsOK = false;
+    if (!IsOK) fprintf(stderr,"%s: could not write the puzzles\n",argv[0]);
+    return IsOK ? 0 : 1;
+}
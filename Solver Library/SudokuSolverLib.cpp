@@ -0,0 +1,190 @@
+//
+//  SudokuSolverLib.cpp
+//  Solver Library
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+
+#include "SudokuSolverLib.h"
+#include "BoardManager.hpp"
+#include "SolveCache.hpp"
+#include "SudokuConstants.h"
+#include <string.h>
+#include <stddef.h>
+#include <new>
+
+
+// The board manager is kept from call to call, so its solver and its index tables are made only once
+struct SudokuSolver
+{
+    BoardManager Manager;
+    size_t BoardSize, CandidateWords;
+    
+    SudokuSolver(uint BlockRows, uint BlockCols, SolverParameters &Params):
+        Manager(BlockRows,BlockCols,Params),
+        BoardSize(Manager.GetBoardSize()), CandidateWords(Manager.GetCandidateWords()) {}
+};
+
+
+struct SudokuCache
+{
+    SolveCache Cache;
+    
+    SudokuCache(size_t MaxBytes): Cache(MaxBytes) {}
+};
+
+
+// Whether a caller's struct of that size has that field
+#define PARAMS_HAS(StructSize,Field) \
+    (offsetof(SudokuParams,Field) + sizeof(((SudokuParams *)0)->Field) <= (StructSize))
+
+// The size from before any field was added, and the size of this version
+static bool IsParamsSizeOK(size_t StructSize)
+{
+    return PARAMS_HAS(StructSize,UseExactCover) && StructSize <= sizeof(SudokuParams);
+}
+
+// Fields past the caller's struct keep SolverParams's defaults
+static void ToSolverParameters(const SudokuParams &Params, SolverParameters &SolverParams)
+{
+    size_t Size = Params.StructSize;
+    SolverParams.MaxVisibleSetSize = Params.MaxVisibleSetSize;
+    SolverParams.MaxHiddenSetSize = Params.MaxHiddenSetSize;
+    SolverParams.UseIntersections = (Params.UseIntersections != 0);
+    SolverParams.UseSearch = (Params.UseSearch != 0);
+    SolverParams.SearchSetSize = Params.SearchSetSize;
+    SolverParams.SearchThreads = Params.SearchThreads;
+    SolverParams.UseExactCover = (Params.UseExactCover != 0);
+    if (PARAMS_HAS(Size,MaxFishSize)) SolverParams.MaxFishSize = Params.MaxFishSize;
+    if (PARAMS_HAS(Size,UseXYWing)) SolverParams.UseXYWing = (Params.UseXYWing != 0);
+    if (PARAMS_HAS(Size,UseXYZWing)) SolverParams.UseXYZWing = (Params.UseXYZWing != 0);
+    if (PARAMS_HAS(Size,UseColoring)) SolverParams.UseColoring = (Params.UseColoring != 0);
+}
+
+
+int SudokuDefaultParams(SudokuParams *Params, size_t StructSize)
+{
+    if (!IsParamsSizeOK(StructSize)) return 0;
+    
+    SolverParameters SolverParams;
+    Params->StructSize = StructSize;
+    Params->MaxVisibleSetSize = SolverParams.MaxVisibleSetSize;
+    Params->MaxHiddenSetSize = SolverParams.MaxHiddenSetSize;
+    Params->UseIntersections = SolverParams.UseIntersections;
+    Params->UseSearch = SolverParams.UseSearch;
+    Params->SearchSetSize = SolverParams.SearchSetSize;
+    Params->SearchThreads = SolverParams.SearchThreads;
+    Params->UseExactCover = SolverParams.UseExactCover;
+    if (PARAMS_HAS(StructSize,MaxFishSize)) Params->MaxFishSize = SolverParams.MaxFishSize;
+    if (PARAMS_HAS(StructSize,UseXYWing)) Params->UseXYWing = SolverParams.UseXYWing;
+    if (PARAMS_HAS(StructSize,UseXYZWing)) Params->UseXYZWing = SolverParams.UseXYZWing;
+    if (PARAMS_HAS(StructSize,UseColoring)) Params->UseColoring = SolverParams.UseColoring;
+    return 1;
+}
+
+
+SudokuSolver *SudokuCreate(unsigned int BlockRows, unsigned int BlockCols, const SudokuParams *Params)
+{
+    if (BlockRows < MinBlockSize || BlockRows > MaxBlockSize ||
+        BlockCols < MinBlockSize || BlockCols > MaxBlockSize)
+        return NULL;
+    
+    SolverParameters SolverParams;
+    if (Params != NULL)
+    {
+        if (!IsParamsSizeOK(Params->StructSize)) return NULL;
+        ToSolverParameters(*Params,SolverParams);
+    }
+    
+    // Exceptions must not cross into C code
+    try {
+        return new SudokuSolver(BlockRows,BlockCols,SolverParams);
+    }
+    catch (std::bad_alloc &) {
+        return NULL;
+    }
+}
+
+void SudokuDestroy(SudokuSolver *Solver)
+{
+    delete Solver;
+}
+
+
+size_t SudokuBoardSize(const SudokuSolver *Solver)
+{
+    return Solver->BoardSize;
+}
+
+size_t SudokuCandidateWords(const SudokuSolver *Solver)
+{
+    return Solver->CandidateWords;
+}
+
+
+size_t SudokuSolveBoards(SudokuSolver *Solver, size_t NumBoards,
+                         const unsigned char *Vals, unsigned char *SolvedVals,
+                         uint64_t *Candidates)
+{
+    BoardManager &BM = Solver->Manager;
+    uint SideLength = BM.GetSideLength();
+    size_t BoardSize = Solver->BoardSize;
+    size_t NumMaskWords = BoardSize*Solver->CandidateWords;
+    
+    size_t NumSolved = 0;
+    for (size_t ib=0; ib<NumBoards; ib++)
+    {
+        const byte *BoardVals = Vals + BoardSize*ib;
+        byte *BoardSolved = SolvedVals + BoardSize*ib;
+        uint64_t *BoardMasks = (Candidates != NULL) ? Candidates + NumMaskWords*ib : NULL;
+        
+        bool IsOK = true;
+        for (size_t ic=0; ic<BoardSize; ic++)
+            if (BoardVals[ic] > SideLength) {IsOK = false; break;}
+        if (!IsOK)
+        {
+            if (BoardSolved != BoardVals) memcpy(BoardSolved,BoardVals,BoardSize);
+            if (BoardMasks != NULL) memset(BoardMasks,0,NumMaskWords*sizeof(uint64_t));
+            continue;
+        }
+        
+        BM.SetValues(BoardVals);
+        BM.SolveAndUpdate();
+        BM.GetValues(BoardSolved);
+        if (BoardMasks != NULL) BM.GetCandidates(BoardMasks);
+        
+        if (memchr(BoardSolved,0,BoardSize) == NULL) NumSolved++;
+    }
+    
+    return NumSolved;
+}
+
+
+SudokuCache *SudokuCacheCreate(size_t MaxBytes)
+{
+    try {
+        return new SudokuCache(MaxBytes);
+    }
+    catch (std::bad_alloc &) {
+        return NULL;
+    }
+}
+
+void SudokuCacheDestroy(SudokuCache *Cache)
+{
+    delete Cache;
+}
+
+void SudokuSetCache(SudokuSolver *Solver, SudokuCache *Cache)
+{
+    Solver->Manager.SetCache((Cache != NULL) ? &Cache->Cache : NULL);
+}
+
+void SudokuCacheCounts(SudokuCache *Cache, unsigned long long *Hits,
+                       unsigned long long *Misses, unsigned long long *Evictions)
+{
+    SolveCacheCounts Counts = Cache->Cache.GetCounts();
+    if (Hits != NULL) *Hits = Counts.Hits;
+    if (Misses != NULL) *Misses = Counts.Misses;
+    if (Evictions != NULL) *Evictions = Counts.Evictions;
+}
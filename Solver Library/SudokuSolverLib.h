@@ -0,0 +1,101 @@
+//
+//  SudokuSolverLib.h
+//  Solver Library
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// C interface to the solver, for calling it in-process from other languages and services.
+// A solver handle is made once for a block size and solver parameters,
+// and each call solves a whole array of boards with it, with no per-cell or per-board calls.
+//
+// Boards are contiguous arrays of cell values, row by row, as BoardImport() and BoardExport() use,
+// with 0 for an empty cell and 1 to the side length for the others.
+//
+// A handle is not thread-safe: give each thread its own.
+// A cache of solve results can be shared by the handles of all the threads, however.
+//
+
+#ifndef SudokuSolverLib_h
+#define SudokuSolverLib_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+#define SUDOKU_API __attribute__((visibility("default")))
+#else
+#define SUDOKU_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Like SolverParameters, with ints for the flags.
+// StructSize is sizeof(SudokuParams) as the caller was built with, as SudokuDefaultParams() sets it.
+// New fields only ever go at the end, and the library uses its defaults for those past StructSize,
+// so that callers built with an older version of this header keep working
+typedef struct SudokuParams
+{
+    size_t StructSize;
+    unsigned int MaxVisibleSetSize;
+    unsigned int MaxHiddenSetSize;
+    int UseIntersections;
+    int UseSearch;
+    unsigned int SearchSetSize;
+    unsigned int SearchThreads;
+    int UseExactCover;
+    unsigned int MaxFishSize;
+    int UseXYWing;
+    int UseXYZWing;
+    int UseColoring;
+} SudokuParams;
+
+typedef struct SudokuSolver SudokuSolver;
+typedef struct SudokuCache SudokuCache;
+
+// Sets the parameters to the app's defaults; StructSize must be sizeof(SudokuParams).
+// Returns 0 without touching them if StructSize is too small or bigger than this library knows
+SUDOKU_API int SudokuDefaultParams(SudokuParams *Params, size_t StructSize);
+
+// Makes a solver for boards with that block size; NULL Params means the defaults.
+// Returns NULL if the block size is out of range or if Params->StructSize is not one it accepts
+SUDOKU_API SudokuSolver *SudokuCreate(unsigned int BlockRows, unsigned int BlockCols,
+                                      const SudokuParams *Params);
+SUDOKU_API void SudokuDestroy(SudokuSolver *Solver);
+
+// Cells per board, and 64-bit candidate-mask words per cell
+SUDOKU_API size_t SudokuBoardSize(const SudokuSolver *Solver);
+SUDOKU_API size_t SudokuCandidateWords(const SudokuSolver *Solver);
+
+// Solves NumBoards boards, NumBoards*SudokuBoardSize() values in Vals.
+// SolvedVals gets the same number of values: the solved ones and 0 for the cells still open.
+// It may be the same as Vals.
+// Candidates, if not NULL, gets each cell's candidates as bit masks, value ival being bit ival-1,
+// in NumBoards*SudokuBoardSize()*SudokuCandidateWords() words.
+// A board with a value out of range is returned as it is, with no candidates.
+// Returns how many boards were solved completely
+SUDOKU_API size_t SudokuSolveBoards(SudokuSolver *Solver, size_t NumBoards,
+                                    const unsigned char *Vals, unsigned char *SolvedVals,
+                                    uint64_t *Candidates);
+
+// Makes a cache of solve results that uses at most about MaxBytes of memory,
+// dropping the least-recently-used results to stay within it.
+// Returns NULL if it cannot be made
+SUDOKU_API SudokuCache *SudokuCacheCreate(size_t MaxBytes);
+SUDOKU_API void SudokuCacheDestroy(SudokuCache *Cache);
+
+// Makes a solver look up each board in the cache before solving it, and add it after solving it.
+// The cache must outlive the solver, or be unset first with NULL
+SUDOKU_API void SudokuSetCache(SudokuSolver *Solver, SudokuCache *Cache);
+
+// The lookups that found a result and those that did not, and the results dropped.
+// Any of them may be NULL
+SUDOKU_API void SudokuCacheCounts(SudokuCache *Cache, unsigned long long *Hits,
+                                  unsigned long long *Misses, unsigned long long *Evictions);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SudokuSolverLib_h */
@@ -11,38 +11,19 @@
 #import "BoardSetup.h"
 #import "SudokuBoard.h"
 #import "SolverParametersSetup.h"
+#import "PuzzleReader.hpp"
 
 
-bool ReadValue(FILE *f, uint &Value, uint MinVal, uint MaxVal, NSString *What)
+// Shows why a file could not be read
+void ShowReadError(const char *Msg)
 {
-    NSString *Desc;
-    int rc = fscanf(f,"%u",&Value);
-    
-    if (rc < 1)
-    {
-        Desc = @"unable to read it";
-        goto BadValue;
-    }
-    if (Value < MinVal || Value > MaxVal)
-    {
-        Desc = [NSString stringWithFormat:@"%u is outside %u to %u", Value, MinVal, MaxVal];
-        goto BadValue;
-    }
-    return true;
-    
-BadValue:
-    
-    NSString *Msg = [NSString stringWithFormat:@"%@: %@", What, Desc];
-    
     NSAlert *Alert = [[NSAlert alloc] init];
     [Alert addButtonWithTitle:@"OK"];
-    Alert.messageText = Msg;
+    Alert.messageText = [NSString stringWithUTF8String:Msg];
     Alert.informativeText = @"Could not create a Sudoku board.";
     Alert.alertStyle = NSAlertStyleCritical;
     
     [Alert runModal];
-    
-    return false;
 }
 
 
@@ -83,35 +64,24 @@ BadValue:
      NSString *FilePath = FileRef.path;
      const char *FilePathCStr = [FilePath fileSystemRepresentation];
      
-     // Read in the file and load up a data array
-     
-     FILE *f = fopen(FilePathCStr,"r");
-     
-     uint BlockRows, BlockCols, SideLength, BoardSize;
-     
-     if (!ReadValue(f, BlockRows, MinBlockSize, MaxBlockSize, @"Number of rows")) return;
-     if (!ReadValue(f, BlockCols, MinBlockSize, MaxBlockSize, @"Number of columns")) return;
-     SideLength = BlockRows * BlockCols;
-     BoardSize = SideLength * SideLength;
+     // Read in the file and load up a data array: the first puzzle in it
      
-     uint ix = 0;
-     byte *Data = new byte[BoardSize];
-     for (int irow=0; irow<SideLength; irow++)
+     PuzzleMap Contents;
+     Puzzle FirstPuzzle;
+     string Error;
+     if (!Contents.Open(FilePathCStr,Error))
      {
-         for (int icol=0; icol<SideLength; icol++)
-         {
-             uint Value;
-             if (!ReadValue(f, Value, 0, SideLength, @"Cell value"))
-             {
-                 delete []Data;
-                 return;
-             }
-             Data[ix] = Value;
-             ix++;
-         }
+         ShowReadError(Error.c_str());
+         return;
      }
-     
-     fclose(f);
+     PuzzleScanner Scanner(Contents.Begin(),Contents.End(),PuzzleFormatText);
+     if (!Scanner.Next(FirstPuzzle))
+     {
+         ShowReadError(Scanner.HasError() ? Scanner.GetError().c_str() : "no puzzle in the file");
+         return;
+     }
+     uint BlockRows = FirstPuzzle.BlockRows, BlockCols = FirstPuzzle.BlockCols;
+     byte *Data = &FirstPuzzle.Vals[0];
      
      SolverParameters SolverParams;
      SolverParametersSetup *SPS = [[SolverParametersSetup alloc] initWithParams:SolverParams];
@@ -124,8 +94,6 @@ BadValue:
      SudokuBoard *Board = [[SudokuBoard alloc] initWithRows:BlockRows Cols:BlockCols Params:SolverParams Data:Data];
      [Board showWindow:self];
      [WindowList addObject:Board];
-     
-     delete []Data;
  }
 
 - (IBAction)openDocument:(id)sender
@@ -11,16 +11,8 @@
 #include <algorithm>
 #include "BoardManager.hpp"
 #include "Solver.hpp"
-
-
-static uint VectorSum(byte *Vec, uint IndMin, uint IndMax)
-{
-    uint Sum = 0;
-    for (uint i=IndMin; i<=IndMax; i++)
-        Sum += Vec[i];
-    
-    return Sum;
-}
+#include "DancingLinks.hpp"
+#include "SolveCache.hpp"
 
 
 BoardManager::BoardManager(uint BlockRows_, uint BlockCols_, SolverParameters &Params_)
@@ -35,72 +27,134 @@ BoardManager::BoardManager(uint BlockRows_, uint BlockCols_, SolverParameters &P
     fill(BoardVals.begin(),BoardVals.end(),0);
     
     // Initialize the availability as all possible
-    uint AvailSize = (SideLength+1)*BoardSize;
-    AvailVals.resize(AvailSize);
-    fill(AvailVals.begin(),AvailVals.end(),1);
+    SolverPtr = MakeSolver(BlockRows,BlockCols);
     
     // Solver parameters
     Params = Params_;
+    
+    Cache = NULL;
+}
+
+BoardManager::~BoardManager()
+{
+    delete SolverPtr;
+}
+
+
+// Find which values are available
+bool BoardManager::Avail(uint irow, uint icol, uint ival)
+{
+    return SolverPtr->Avail(irow,icol,ival);
+}
+
+void BoardManager::GetCandidates(uint64_t *Masks)
+{
+    SolverPtr->GetCandidates(Masks);
+}
+
+void BoardManager::SetCandidates(const uint64_t *Masks)
+{
+    SolverPtr->SetCandidates(Masks);
+    SolverPtr->GetValues(&BoardVals[0]);
 }
 
 
 // Solve the board
 void BoardManager::SolveAndUpdate()
 {
-    // Set cell availabilities from the cell values
-    for (uint irow=0; irow<SideLength; irow++)
+    if (Cache != NULL)
     {
-        for (uint icol=0; icol<SideLength; icol++)
+        SolveCache::MakeKey(BlockRows,BlockCols,Params,&BoardVals[0],BoardSize,CacheKey);
+        CacheMasks.resize(BoardSize*GetCandidateWords());
+        if (Cache->Find(CacheKey,&CacheMasks[0],CacheMasks.size()))
         {
-            byte CellVal = Value(irow,icol);
-            byte *CellAvail = &Avail(irow,icol,0);
-            for (uint ival=1; ival<=SideLength; ival++)
-            {
-                CellAvail[ival] = (CellVal > 0) ? ((ival == CellVal) ? 1 : 0) : 1;
-            }
+            SetCandidates(&CacheMasks[0]);
+            return;
         }
+        Solve();
+        SolverPtr->GetCandidates(&CacheMasks[0]);
+        Cache->Add(CacheKey,&CacheMasks[0],CacheMasks.size());
     }
+    else
+        Solve();
+}
+
+void BoardManager::Solve()
+{
+    // Exact cover: the candidates become the solution
+    if (Params.UseExactCover && SolveExactCover(1) > 0) return;
     
-    // Check on changes using availability array
-    vector<byte> PrevAvailVals(AvailVals);
+    // Set cell availabilities from the cell values
+    SolverPtr->SetFromValues(&BoardVals[0]);
+    
+    // Iterate over the solution code until it makes no more changes
+    SolverPtr->Solve(Params);
+    
+    // If the solution code stalls, search for a solution,
+    // unless exact cover has already found that there is none
+    if (Params.UseSearch && !Params.UseExactCover) SolverPtr->Search(Params);
     
-    // Iterate over the solution code
-    // Check for changes at each iteration
-    bool ContinueSolving = false;
-    do {
-        Solve(*this, Params);
-        
-        // Check on whether AvailVals has changed
-        ContinueSolving = !equal(AvailVals.begin(),AvailVals.end(),PrevAvailVals.begin());
-        
-        // Push down the current value for the next iteration
-        PrevAvailVals = AvailVals;
-        
-    } while(ContinueSolving);
-
     // Set cell values from the cell availabilities
-    for (uint irow=0; irow<SideLength; irow++)
+    SolverPtr->GetValues(&BoardVals[0]);
+}
+
+// Grade the board in one solve
+void BoardManager::Grade(SolverGrade &Grade)
+{
+    SolverPtr->SetFromValues(&BoardVals[0]);
+    SolverPtr->Grade(Params,Grade);
+    SolverPtr->GetValues(&BoardVals[0]);
+}
+
+// Count the board's solutions
+uint BoardManager::CountSolutions(uint MaxCount)
+{
+    if (Params.UseExactCover)
     {
-        for (uint icol=0; icol<SideLength; icol++)
+        uint Count = SolveExactCover(MaxCount);
+        if (Count == 0)
         {
-            byte *CellAvail = &Avail(irow,icol,0);
-            uint Sum = VectorSum(CellAvail,1,SideLength);
-            if (Sum == 1)
-            {
-                for (uint ival=1; ival<=SideLength; ival++)
-                {
-                    if (CellAvail[ival] != 0)
-                    {
-                        Value(irow,icol) = ival;
-                    }
-                }
-                
-            }
-            else
-            {
-                Value(irow,icol) = 0;
-            }
+            // No solution, so show what the solution code finds
+            SolverPtr->SetFromValues(&BoardVals[0]);
+            SolverPtr->Solve(Params);
+            SolverPtr->GetValues(&BoardVals[0]);
         }
+        return Count;
     }
+    
+    // Set cell availabilities from the cell values
+    SolverPtr->SetFromValues(&BoardVals[0]);
+    
+    // Eliminate what the solution code can before searching
+    SolverPtr->Solve(Params);
+    
+    uint Count = SolverPtr->CountSolutions(Params,MaxCount);
+    
+    // Set cell values from the cell availabilities
+    SolverPtr->GetValues(&BoardVals[0]);
+    
+    return Count;
+}
+
+// The solution techniques' statistics
+void BoardManager::GetStats(vector<TechniqueStats> &Stats)
+{
+    SolverPtr->GetStats(Stats);
+}
 
+void BoardManager::ClearStats()
+{
+    SolverPtr->ClearStats();
+}
+
+// Solve with exact cover
+uint BoardManager::SolveExactCover(uint MaxCount)
+{
+    DancingLinks ExactCover(BlockRows,BlockCols);
+    uint Count = ExactCover.Solve(&BoardVals[0],MaxCount);
+    
+    // Keep the candidates in step with the values
+    if (Count > 0) SolverPtr->SetFromValues(&BoardVals[0]);
+    
+    return Count;
 }
@@ -10,25 +10,52 @@
 #define BoardManager_hpp
 
 #include "SolverParameters.h"
+#include "SolverStats.h"
+#include "SolverGrade.h"
 
+#include <stdint.h>
+#include <string>
 #include <vector>
+#include <algorithm>
 using namespace std;
 
 typedef unsigned char byte;
 typedef unsigned int uint;
 
+class Solver;
+class SolveCache;
+
 class BoardManager
 {
     uint BlockRows, BlockCols, SideLength, BoardSize;
     
     vector<byte> BoardVals;
-    vector<byte> AvailVals;
+    
+    // Has the available values, as bit vectors
+    Solver *SolverPtr;
     
     SolverParameters Params;
+    
+    // Not owned, since it can be shared; NULL for none
+    SolveCache *Cache;
+    string CacheKey;
+    vector<uint64_t> CacheMasks;
+    
+    // Not copyable, since it owns the solver
+    BoardManager(const BoardManager &) = delete;
+    BoardManager &operator=(const BoardManager &) = delete;
+    
+    // Finds solutions by exact cover, stopping at MaxCount, and returns how many it found.
+    // If it found any, the values and the candidates become the first one
+    uint SolveExactCover(uint MaxCount);
+    
+    // Solves without the cache
+    void Solve();
 
 public:
     // Create with a block size that will stay fixed
     BoardManager(uint BlockRows_, uint BlockCols_, SolverParameters &Params_);
+    ~BoardManager();
     
     // Get the dimensions and the solver parameters
     uint GetBlockRows() {return BlockRows;}
@@ -40,14 +67,43 @@ public:
     // Set and get the values
     byte &Value(uint irow, uint icol) {return BoardVals[SideLength*irow+icol];}
     
+    // Set and get all of them at once, row by row, as BoardImport() and BoardExport() do
+    void SetValues(const byte *Vals) {copy(Vals,Vals+BoardSize,BoardVals.begin());}
+    void GetValues(byte *Vals) {copy(BoardVals.begin(),BoardVals.end(),Vals);}
+    
     // Find which values are available
-    // Values for each cell have indices 0 to SideLength for convenience in indexing
-    // Made writable here for convenience in passing to a solver function
-    byte &Avail(uint irow, uint icol, uint ival)
-    {return AvailVals[(SideLength+1)*(SideLength*irow+icol)+ival];}
+    // Values for each cell have indices 1 to SideLength
+    bool Avail(uint irow, uint icol, uint ival);
     
-    // Solve the board
+    // All of them as bit masks, value ival being bit ival-1,
+    // in GetCandidateWords() 64-bit words per cell, row by row
+    uint GetCandidateWords() {return (SideLength+63)/64;}
+    void GetCandidates(uint64_t *Masks);
+    
+    // Restores a solved board from its candidates, as GetCandidates() gave them after solving,
+    // instead of solving it again. The values become those of the cells with only one candidate
+    void SetCandidates(const uint64_t *Masks);
+    
+    // Use a cache of solve results, or NULL for none. It must outlive this board manager
+    void SetCache(SolveCache *Cache_) {Cache = Cache_;}
+    SolveCache *GetCache() {return Cache;}
+    
+    // Solve the board, or take the result from the cache if it has it
     void SolveAndUpdate();
+    
+    // Solve the board in grading order, with the solver parameters as the hardest techniques to try,
+    // and get its grade. It uses neither search, exact cover, nor the cache
+    void Grade(SolverGrade &Grade);
+    
+    // Count the board's solutions, stopping at MaxCount
+    // Use MaxCount = 2 to find whether there are none, one, or more than one
+    // The values become the first solution found, if there is one
+    uint CountSolutions(uint MaxCount = 2);
+    
+    // The solution techniques' statistics over all the solving since they were last cleared
+    // There are none unless SOLVER_STATS is 1
+    void GetStats(vector<TechniqueStats> &Stats);
+    void ClearStats();
 };
 
 #endif /* BoardManager_hpp */
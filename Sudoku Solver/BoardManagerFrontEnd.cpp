@@ -84,6 +84,25 @@ byte BoardManagerFrontEnd::Avail(uint irow, uint icol, uint ival)
     return BMP->Avail(irow,icol,ival);
 }
 
+// Get and set all the candidates
+uint BoardManagerFrontEnd::GetCandidateWords()
+{
+    BoardManager *BMP = (BoardManager *)BoardManagerPtr;
+    return BMP->GetCandidateWords();
+}
+
+void BoardManagerFrontEnd::GetCandidates(uint64_t *Masks)
+{
+    BoardManager *BMP = (BoardManager *)BoardManagerPtr;
+    BMP->GetCandidates(Masks);
+}
+
+void BoardManagerFrontEnd::SetCandidates(const uint64_t *Masks)
+{
+    BoardManager *BMP = (BoardManager *)BoardManagerPtr;
+    BMP->SetCandidates(Masks);
+}
+
 
 // Solve the board
 void BoardManagerFrontEnd::SolveAndUpdate()
@@ -91,3 +110,23 @@ void BoardManagerFrontEnd::SolveAndUpdate()
     BoardManager *BMP = (BoardManager *)BoardManagerPtr;
     BMP->SolveAndUpdate();
 }
+
+// Count the board's solutions
+uint BoardManagerFrontEnd::CountSolutions(uint MaxCount)
+{
+    BoardManager *BMP = (BoardManager *)BoardManagerPtr;
+    return BMP->CountSolutions(MaxCount);
+}
+
+// The solution techniques' statistics
+void BoardManagerFrontEnd::GetStats(vector<TechniqueStats> &Stats)
+{
+    BoardManager *BMP = (BoardManager *)BoardManagerPtr;
+    BMP->GetStats(Stats);
+}
+
+void BoardManagerFrontEnd::ClearStats()
+{
+    BoardManager *BMP = (BoardManager *)BoardManagerPtr;
+    BMP->ClearStats();
+}
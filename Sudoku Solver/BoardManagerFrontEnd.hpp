@@ -12,6 +12,9 @@
 #define BoardManagerFrontEnd_hpp
 
 #include "SolverParameters.h"
+#include "SolverStats.h"
+
+#include <stdint.h>
 
 typedef unsigned int uint;
 typedef unsigned char byte;
@@ -39,12 +42,27 @@ public:
     byte &Value(uint irow, uint icol);
     
     // Find which values are available
-    // Values for each cell have indices 0 to SideLength for convenience in indexing
+    // Values for each cell have indices 1 to SideLength
     // Read-only here
     byte Avail(uint irow, uint icol, uint ival);
     
+    // All of them as bit masks, in GetCandidateWords() 64-bit words per cell,
+    // for keeping a solved board and restoring it without solving it again
+    uint GetCandidateWords();
+    void GetCandidates(uint64_t *Masks);
+    void SetCandidates(const uint64_t *Masks);
+    
     // Solve the board
     void SolveAndUpdate();
+    
+    // Count the board's solutions, stopping at MaxCount
+    // The values become the first solution found, if there is one
+    uint CountSolutions(uint MaxCount = 2);
+    
+    // The solution techniques' statistics since they were last cleared
+    // There are none unless SOLVER_STATS is 1
+    void GetStats(vector<TechniqueStats> &Stats);
+    void ClearStats();
 };
 
 
@@ -9,6 +9,7 @@
 #ifndef BooleanVecOps_hpp
 #define BooleanVecOps_hpp
 #include <algorithm>
+#include <stdint.h>
 using namespace std;
 
 
@@ -16,35 +17,83 @@ typedef unsigned char byte;
 typedef unsigned int uint;
 
 
-// Scalar Boolean operations
-inline byte ByteNot(byte x) {return (x != 0) ? 0 : 1;}
-inline byte ByteAnd(byte x, byte y) {return min(x,y);}
-inline byte ByteOr(byte x, byte y) {return max(x,y);}
-inline byte ByteSub(byte x, byte y) {return ByteAnd(x,ByteNot(y));}
-inline byte ByteXor(byte x, byte y) {return (x == y) ? 0 : 1;}
+// Bit-vector Boolean operations
+// A whole set of values is packed into one bit vector: value ival is bit (ival-1)
+// Union, intersection, and difference are single bitwise operations,
+// and counting is a population count.
+// Sizes: 16 bits for up to 16 values, 64 bits for up to 64, 128 bits for up to 128
 
-// Vector Boolean operations
-// Note: in all these functions, the result is the first operand and not the last one
-// It is followed by the minimum and maximum vector indices to operate on (both inclusive)
+typedef uint16_t BitVec16;
+typedef uint64_t BitVec64;
 
-void VecSet(byte *Vec, uint IndMin, uint IndMax, byte Val);
-inline void VecFalse(byte *Vec, uint IndMin, uint IndMax) {VecSet(Vec,IndMin,IndMax,0);}
-inline void VecTrue(byte *Vec, uint IndMin, uint IndMax) {VecSet(Vec,IndMin,IndMax,1);}
+struct BitVec128
+{
+    uint64_t Lo, Hi;
+    
+    BitVec128() noexcept: Lo(0), Hi(0) {}
+    BitVec128(uint64_t Lo_) noexcept: Lo(Lo_), Hi(0) {}
+    BitVec128(uint64_t Lo_, uint64_t Hi_) noexcept: Lo(Lo_), Hi(Hi_) {}
+};
 
-void VecCopy(byte *Vec, uint IndMin, uint IndMax, byte *Src);
+inline BitVec128 operator~(BitVec128 x) {return BitVec128(~x.Lo,~x.Hi);}
+inline BitVec128 operator&(BitVec128 x, BitVec128 y) {return BitVec128(x.Lo&y.Lo,x.Hi&y.Hi);}
+inline BitVec128 operator|(BitVec128 x, BitVec128 y) {return BitVec128(x.Lo|y.Lo,x.Hi|y.Hi);}
+inline BitVec128 operator^(BitVec128 x, BitVec128 y) {return BitVec128(x.Lo^y.Lo,x.Hi^y.Hi);}
+inline BitVec128 &operator&=(BitVec128 &x, BitVec128 y) {x.Lo &= y.Lo; x.Hi &= y.Hi; return x;}
+inline BitVec128 &operator|=(BitVec128 &x, BitVec128 y) {x.Lo |= y.Lo; x.Hi |= y.Hi; return x;}
+inline bool operator==(BitVec128 x, BitVec128 y) {return x.Lo == y.Lo && x.Hi == y.Hi;}
+inline bool operator!=(BitVec128 x, BitVec128 y) {return !(x == y);}
 
-void VecNot(byte *Vec, uint IndMin, uint IndMax, byte *Src);
-void VecNotAt(byte *Vec, uint IndMin, uint IndMax);
+// Number of members
+inline uint BitCount(BitVec16 x) {return __builtin_popcount(x);}
+inline uint BitCount(BitVec64 x) {return __builtin_popcountll(x);}
+inline uint BitCount(BitVec128 x) {return __builtin_popcountll(x.Lo) + __builtin_popcountll(x.Hi);}
 
-void VecAnd(byte *Vec, uint IndMin, uint IndMax, byte *Src, byte *Srcx);
-void VecAndTo(byte *Vec, uint IndMin, uint IndMax, byte *Src);
+// Index of the first member; the vector must be nonempty
+inline uint BitFirst(BitVec16 x) {return __builtin_ctz(x);}
+inline uint BitFirst(BitVec64 x) {return __builtin_ctzll(x);}
+inline uint BitFirst(BitVec128 x) {return (x.Lo != 0) ? __builtin_ctzll(x.Lo) : 64 + __builtin_ctzll(x.Hi);}
 
-void VecOr(byte *Vec, uint IndMin, uint IndMax, byte *Src, byte *Srcx);
-void VecOrTo(byte *Vec, uint IndMin, uint IndMax, byte *Src);
+// Removes the first member
+inline BitVec16 BitClearFirst(BitVec16 x) {return x & (x-1);}
+inline BitVec64 BitClearFirst(BitVec64 x) {return x & (x-1);}
+inline BitVec128 BitClearFirst(BitVec128 x)
+{return (x.Lo != 0) ? BitVec128(x.Lo & (x.Lo-1),x.Hi) : BitVec128(0,x.Hi & (x.Hi-1));}
 
-void VecSub(byte *Vec, uint IndMin, uint IndMax, byte *Src, byte *Srcx);
-void VecSubFm(byte *Vec, uint IndMin, uint IndMax, byte *Src);
+// Is bit ibit a member?
+inline bool BitTest(BitVec16 x, uint ibit) {return ((x >> ibit) & 1) != 0;}
+inline bool BitTest(BitVec64 x, uint ibit) {return ((x >> ibit) & 1) != 0;}
+inline bool BitTest(BitVec128 x, uint ibit)
+{return (ibit < 64) ? (((x.Lo >> ibit) & 1) != 0) : (((x.Hi >> (ibit-64)) & 1) != 0);}
 
-bool VecSubFmCheck(byte *Vec, uint IndMin, uint IndMax, byte *Src);
+// Only bit ibit
+template<class BV> inline BV BitSingle(uint ibit) {return (BV)((BV)1 << ibit);}
+template<> inline BitVec128 BitSingle<BitVec128>(uint ibit)
+{return (ibit < 64) ? BitVec128(uint64_t(1) << ibit,0) : BitVec128(0,uint64_t(1) << (ibit-64));}
+
+// Bits 0 to (Num-1)
+template<class BV> inline BV BitRange(uint Num)
+{return (Num >= 8*sizeof(BV)) ? (BV)(~(BV)0) : (BV)(((BV)1 << Num) - 1);}
+template<> inline BitVec128 BitRange<BitVec128>(uint Num)
+{return (Num >= 64) ? BitVec128(~uint64_t(0),BitRange<BitVec64>(Num-64)) : BitVec128(BitRange<BitVec64>(Num),0);}
+
+// 64-bit word iword, for handing the bits outside
+inline uint64_t BitWord(BitVec16 x, uint iword) {return (iword == 0) ? x : 0;}
+inline uint64_t BitWord(BitVec64 x, uint iword) {return (iword == 0) ? x : 0;}
+inline uint64_t BitWord(BitVec128 x, uint iword) {return (iword == 0) ? x.Lo : (iword == 1) ? x.Hi : 0;}
+
+// From those words, for taking the bits back
+template<class BV> inline BV BitFromWords(const uint64_t *Words) {return (BV)Words[0];}
+template<> inline BitVec128 BitFromWords<BitVec128>(const uint64_t *Words) {return BitVec128(Words[0],Words[1]);}
+
+// The first operand is the result
+template<class BV> inline void BitSubFm(BV &Vec, BV Src) {Vec = Vec & ~Src;}
+template<class BV> inline bool BitSubFmCheck(BV &Vec, BV Src)
+{
+    BV NewVec = Vec & ~Src;
+    bool rc = (NewVec != Vec);
+    Vec = NewVec;
+    return rc;
+}
 
 #endif /* BooleanVecOps_hpp */
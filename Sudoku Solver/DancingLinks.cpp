@@ -0,0 +1,234 @@
+//
+//  DancingLinks.cpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+
+#include "DancingLinks.hpp"
+#include <algorithm>
+
+
+// The constraint columns: cells, then row values, then column values, then block values,
+// each SideLength*SideLength of them. Column headers are nodes 1 and up
+
+DancingLinks::DancingLinks(uint BlockRows_, uint BlockCols_)
+{
+    BlockRows = BlockRows_;
+    BlockCols = BlockCols_;
+    SideLength = BlockRows * BlockCols;
+    BoardSize = SideLength * SideLength;
+    ExcludedCand = NoCandidate;
+    NumNodes = MaxNodes = 0;
+}
+
+
+uint DancingLinks::AddNode(uint icol, uint icand)
+{
+    uint inode = (uint)Left.size();
+    
+    // At the bottom of the column
+    uint ihdr = icol + 1;
+    Up.push_back(Up[ihdr]);
+    Down.push_back(ihdr);
+    Down[Up[ihdr]] = inode;
+    Up[ihdr] = inode;
+    
+    Left.push_back(inode);
+    Right.push_back(inode);
+    Column.push_back(ihdr);
+    Candidate.push_back(icand);
+    ColSize[ihdr]++;
+    
+    return inode;
+}
+
+
+bool DancingLinks::Build(byte *Vals)
+{
+    uint NumCols = 4*BoardSize;
+    uint NumHeaders = NumCols + 1;
+    
+    Left.resize(NumHeaders);
+    Right.resize(NumHeaders);
+    Up.resize(NumHeaders);
+    Down.resize(NumHeaders);
+    Column.resize(NumHeaders);
+    Candidate.resize(NumHeaders);
+    ColSize.resize(NumHeaders);
+    for (uint ihdr=0; ihdr<NumHeaders; ihdr++)
+    {
+        Left[ihdr] = (ihdr > 0) ? ihdr - 1 : NumCols;
+        Right[ihdr] = (ihdr < NumCols) ? ihdr + 1 : 0;
+        Up[ihdr] = Down[ihdr] = Column[ihdr] = ihdr;
+        Candidate[ihdr] = 0;
+        ColSize[ihdr] = 0;
+    }
+    
+    // Which values the givens already have in each row, column, and block
+    vector<byte> RowHas(BoardSize,0), ColHas(BoardSize,0), BlkHas(BoardSize,0);
+    for (uint irow=0; irow<SideLength; irow++)
+    {
+        for (uint icol=0; icol<SideLength; icol++)
+        {
+            uint Val = Vals[SideLength*irow+icol];
+            if (Val == 0) continue;
+            if (Val > SideLength) return false;
+            uint iblk = (irow/BlockRows)*BlockRows + icol/BlockCols;
+            uint iv = Val - 1;
+            if (RowHas[SideLength*irow+iv] || ColHas[SideLength*icol+iv] || BlkHas[SideLength*iblk+iv])
+                return false;
+            RowHas[SideLength*irow+iv] = ColHas[SideLength*icol+iv] = BlkHas[SideLength*iblk+iv] = 1;
+        }
+    }
+    
+    // Rows of the matrix: the candidates that the givens allow.
+    // The givens' own constraints are left out, since they are already satisfied
+    for (uint irow=0; irow<SideLength; irow++)
+    {
+        for (uint icol=0; icol<SideLength; icol++)
+        {
+            uint icell = SideLength*irow + icol;
+            if (Vals[icell] != 0)
+            {
+                // Cover this cell's constraint: unlink its header
+                uint ihdr = icell + 1;
+                Right[Left[ihdr]] = Right[ihdr];
+                Left[Right[ihdr]] = Left[ihdr];
+                continue;
+            }
+            uint iblk = (irow/BlockRows)*BlockRows + icol/BlockCols;
+            for (uint iv=0; iv<SideLength; iv++)
+            {
+                if (RowHas[SideLength*irow+iv] || ColHas[SideLength*icol+iv] || BlkHas[SideLength*iblk+iv])
+                    continue;
+                uint icand = SideLength*icell + iv;
+                if (icand == ExcludedCand) continue;
+                uint n0 = AddNode(icell,icand);
+                uint n1 = AddNode(BoardSize + SideLength*irow + iv,icand);
+                uint n2 = AddNode(2*BoardSize + SideLength*icol + iv,icand);
+                uint n3 = AddNode(3*BoardSize + SideLength*iblk + iv,icand);
+                Right[n0] = n1; Right[n1] = n2; Right[n2] = n3; Right[n3] = n0;
+                Left[n0] = n3; Left[n1] = n0; Left[n2] = n1; Left[n3] = n2;
+            }
+        }
+    }
+    
+    // Unlink the headers of the givens' row, column, and block constraints
+    for (uint ic=0; ic<BoardSize; ic++)
+    {
+        if (RowHas[ic]) {uint ihdr = BoardSize + ic + 1; Right[Left[ihdr]] = Right[ihdr]; Left[Right[ihdr]] = Left[ihdr];}
+        if (ColHas[ic]) {uint ihdr = 2*BoardSize + ic + 1; Right[Left[ihdr]] = Right[ihdr]; Left[Right[ihdr]] = Left[ihdr];}
+        if (BlkHas[ic]) {uint ihdr = 3*BoardSize + ic + 1; Right[Left[ihdr]] = Right[ihdr]; Left[Right[ihdr]] = Left[ihdr];}
+    }
+    
+    return true;
+}
+
+
+void DancingLinks::Cover(uint icol)
+{
+    Right[Left[icol]] = Right[icol];
+    Left[Right[icol]] = Left[icol];
+    for (uint i=Down[icol]; i!=icol; i=Down[i])
+    {
+        for (uint j=Right[i]; j!=i; j=Right[j])
+        {
+            Down[Up[j]] = Down[j];
+            Up[Down[j]] = Up[j];
+            ColSize[Column[j]]--;
+        }
+    }
+}
+
+void DancingLinks::Uncover(uint icol)
+{
+    for (uint i=Up[icol]; i!=icol; i=Up[i])
+    {
+        for (uint j=Left[i]; j!=i; j=Left[j])
+        {
+            ColSize[Column[j]]++;
+            Down[Up[j]] = j;
+            Up[Down[j]] = j;
+        }
+    }
+    Right[Left[icol]] = icol;
+    Left[Right[icol]] = icol;
+}
+
+
+bool DancingLinks::SearchNode()
+{
+    if (Right[0] == 0)
+    {
+        // Every constraint is covered
+        if (NumSolutions == 0)
+        {
+            for (uint ic=0; ic<Chosen.size(); ic++)
+            {
+                uint icand = Candidate[Chosen[ic]];
+                FirstSolution[icand/SideLength] = icand%SideLength + 1;
+            }
+        }
+        NumSolutions++;
+        return (NumSolutions >= MaxSolutions);
+    }
+    
+    if (++NumNodes > MaxNodes && MaxNodes > 0) return true;
+    
+    // The constraint with the fewest candidates
+    uint icol = Right[0];
+    for (uint j=Right[icol]; j!=0; j=Right[j])
+    {
+        if (ColSize[j] < ColSize[icol]) icol = j;
+        if (ColSize[icol] <= 1) break;
+    }
+    if (ColSize[icol] == 0) return false;
+    
+    Cover(icol);
+    bool Done = false;
+    for (uint i=Down[icol]; i!=icol && !Done; i=Down[i])
+    {
+        Chosen.push_back(i);
+        for (uint j=Right[i]; j!=i; j=Right[j])
+            Cover(Column[j]);
+        
+        Done = SearchNode();
+        
+        for (uint j=Left[i]; j!=i; j=Left[j])
+            Uncover(Column[j]);
+        Chosen.pop_back();
+    }
+    Uncover(icol);
+    
+    return Done;
+}
+
+
+uint DancingLinks::Solve(byte *Vals, uint MaxCount)
+{
+    Left.clear(); Right.clear(); Up.clear(); Down.clear();
+    Column.clear(); Candidate.clear(); ColSize.clear();
+    if (!Build(Vals)) return 0;
+    
+    FirstSolution.assign(Vals,Vals+BoardSize);
+    Chosen.clear();
+    NumSolutions = 0;
+    NumNodes = 0;
+    MaxSolutions = max(MaxCount,1U);
+    
+    SearchNode();
+    
+    if (NumSolutions > 0)
+        copy(FirstSolution.begin(),FirstSolution.end(),Vals);
+    
+    return NumSolutions;
+}
+
+uint DancingLinks::SolveExcluding(byte *Vals, uint icell, uint ival, uint MaxCount)
+{
+    ExcludedCand = SideLength*icell + (ival-1);
+    uint Count = Solve(Vals,MaxCount);
+    ExcludedCand = NoCandidate;
+    return Count;
+}
@@ -0,0 +1,76 @@
+//
+//  DancingLinks.hpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Exact-cover solver: Knuth's Algorithm X with dancing links.
+// Each candidate, a value in a cell, covers four constraints:
+// the cell has a value, and the value is in the row, in the column, and in the block.
+// It solves by search alone, so it is for bulk solving, where explaining the deductions does not matter.
+
+#ifndef DancingLinks_hpp
+#define DancingLinks_hpp
+
+#include <vector>
+#include <stddef.h>
+using namespace std;
+
+typedef unsigned char byte;
+typedef unsigned int uint;
+
+class DancingLinks
+{
+    uint BlockRows, BlockCols, SideLength, BoardSize;
+    
+    // The nodes: the links in all four directions and the column of each one.
+    // Node 0 is the root, then come the column headers, then the candidate rows' nodes
+    vector<uint> Left, Right, Up, Down, Column;
+    // The candidate of each node, as SideLength*icell + (ival-1)
+    vector<uint> Candidate;
+    // Nodes in each column
+    vector<uint> ColSize;
+    
+    // The candidates chosen so far, by their nodes, and the first solution found
+    vector<uint> Chosen;
+    vector<byte> FirstSolution;
+    uint NumSolutions, MaxSolutions;
+    
+    // Search nodes visited, and the limit, 0 for none
+    size_t NumNodes, MaxNodes;
+    
+    // A candidate left out of the matrix, as SideLength*icell + (ival-1), or NoCandidate for none
+    enum {NoCandidate = ~0U};
+    uint ExcludedCand;
+    
+    // Returns whether the values are consistent
+    bool Build(byte *Vals);
+    uint AddNode(uint icol, uint icand);
+    
+    void Cover(uint icol);
+    void Uncover(uint icol);
+    
+    // Returns whether the search is done: whether it has found all the solutions it is looking for
+    bool SearchNode();
+    
+public:
+    // Create with a block size that will stay fixed
+    DancingLinks(uint BlockRows_, uint BlockCols_);
+    
+    // Stop each search after visiting that many search nodes, with 0 being no limit
+    void SetMaxNodes(size_t MaxNodes_) {MaxNodes = MaxNodes_;}
+    
+    // Whether the last search stopped at that limit, so that there may be solutions that it did not find
+    bool HitMaxNodes() {return (MaxNodes > 0 && NumNodes > MaxNodes);}
+    
+    // Finds solutions of the board with those values, with 0 being no value,
+    // stopping at MaxCount, and returns how many it found.
+    // If it found any, the values become the first one, otherwise they stay the same
+    uint Solve(byte *Vals, uint MaxCount = 1);
+    
+    // The same, but only for solutions without that value in that cell.
+    // For a solved board with that cell cleared, finding none means that it is still the only solution
+    uint SolveExcluding(byte *Vals, uint icell, uint ival, uint MaxCount = 1);
+};
+
+#endif /* DancingLinks_hpp */
@@ -7,32 +7,162 @@
 //
 
 #include "HistoryStack.hpp"
+#include <stddef.h>
+#include <algorithm>
 
-HistoryStack::HistoryStack(uint Size_)
+
+template<class T, class IndexType>
+typename HistoryTrack<T,IndexType>::Step HistoryTrack<T,IndexType>::Store(const vector<T> &Base,
+                                                                          const vector<T> &Current)
+{
+    size_t Size = Current.size();
+    size_t NumChanged = 0;
+    for (size_t ix=0; ix<Size; ix++)
+        if (Current[ix] != Base[ix]) NumChanged++;
+    
+    // Whichever is smaller: the changes or both blocks
+    Step NewStep;
+    NewStep.ChangeBegin = Changes.size();
+    NewStep.FrameBegin = Frames.size();
+    NewStep.NumChanges = 0;
+    NewStep.IsFrame = (sizeof(Change)*NumChanged > 2*sizeof(T)*Size);
+    if (NewStep.IsFrame)
+    {
+        Frames.insert(Frames.end(),Base.begin(),Base.end());
+        Frames.insert(Frames.end(),Current.begin(),Current.end());
+    }
+    else
+    {
+        NewStep.NumChanges = NumChanged;
+        for (size_t ix=0; ix<Size; ix++)
+        {
+            if (Current[ix] == Base[ix]) continue;
+            Change NewChange;
+            NewChange.Index = (IndexType)ix;
+            NewChange.Prev = Base[ix];
+            NewChange.Next = Current[ix];
+            Changes.push_back(NewChange);
+        }
+    }
+    return NewStep;
+}
+
+template<class T, class IndexType>
+void HistoryTrack<T,IndexType>::DropFrom(const Step &First)
+{
+    // The steps are stored in order, so the ones after it are after it in both deques
+    Changes.erase(Changes.begin()+First.ChangeBegin,Changes.end());
+    Frames.erase(Frames.begin()+First.FrameBegin,Frames.end());
+}
+
+template<class T, class IndexType>
+void HistoryTrack<T,IndexType>::Undo(const Step &Undone, vector<T> &Current)
+{
+    if (Undone.IsFrame)
+    {
+        typename deque<T>::iterator Before = Frames.begin() + Undone.FrameBegin;
+        copy(Before,Before+Current.size(),Current.begin());
+    }
+    else
+        for (size_t ich=Undone.ChangeBegin; ich<Undone.ChangeBegin+Undone.NumChanges; ich++)
+            Current[Changes[ich].Index] = Changes[ich].Prev;
+}
+
+template<class T, class IndexType>
+void HistoryTrack<T,IndexType>::Redo(const Step &Redone, vector<T> &Current)
+{
+    if (Redone.IsFrame)
+    {
+        typename deque<T>::iterator After = Frames.begin() + Redone.FrameBegin + Current.size();
+        copy(After,After+Current.size(),Current.begin());
+    }
+    else
+        for (size_t ich=Redone.ChangeBegin; ich<Redone.ChangeBegin+Redone.NumChanges; ich++)
+            Current[Changes[ich].Index] = Changes[ich].Next;
+}
+
+
+HistoryStack::HistoryStack(uint Size_, uint MaskSize_)
 {
     Size = Size_;
+    MaskSize = MaskSize_;
     Index = 0;
+    
+    // Before the first block, everything is 0
+    Current.resize(Size);
+    fill(Current.begin(),Current.end(),0);
+    Base = Current;
+    IsPending = false;
+    
+    CurrentMasks.resize(MaskSize);
+    fill(CurrentMasks.begin(),CurrentMasks.end(),0);
+    BaseMasks = CurrentMasks;
+    MasksPending = false;
+}
+
+
+// Stores the pending data and masks, if there are any
+void HistoryStack::Commit()
+{
+    if (IsPending)
+    {
+        IsPending = false;
+        
+        // With no masks yet: the current ones stay as they are, those of the latest step with any
+        Step NewStep;
+        NewStep.Data = DataHistory.Store(Base,Current);
+        NewStep.Masks = MaskHistory.Store(CurrentMasks,CurrentMasks);
+        NewStep.HasMasks = false;
+        Steps.push_back(NewStep);
+    }
+    
+    if (MasksPending)
+    {
+        MasksPending = false;
+        
+        // The latest step's masks had no changes, so they can be replaced
+        Step &Latest = Steps.back();
+        MaskHistory.DropFrom(Latest.Masks);
+        Latest.Masks = MaskHistory.Store(BaseMasks,CurrentMasks);
+        Latest.HasMasks = true;
+    }
 }
 
 
 // For adding data: returns a pointer to add the data to
 byte *HistoryStack::Add()
 {
+    Commit();
+    
     // Initially: size 0 and index 0
-    if (Stack.size() > 0) Index++;
+    if (Steps.size() > 0) Index++;
     
-    Stack.resize((Index+1)*Size);
-    return &Stack[Index*Size];
+    // Drop the steps after this one
+    if (Steps.size() > Index)
+    {
+        DataHistory.DropFrom(Steps[Index].Data);
+        MaskHistory.DropFrom(Steps[Index].Masks);
+        Steps.erase(Steps.begin()+Index,Steps.end());
+    }
+    
+    Base = Current;
+    IsPending = true;
+    return &Current[0];
 }
 
 // Goes back and returns pointer to previous data, or else NULL
 byte *HistoryStack::GoBack()
 {
+    Commit();
     if (!CanGoBack()) return NULL;
     
+    // Undo this step
+    DataHistory.Undo(Steps[Index].Data,Current);
+    MaskHistory.Undo(Steps[Index].Masks,CurrentMasks);
+    
     Index--;
     
-    return &Stack[Index*Size];
+    return &Current[0];
 }
 
 // Goes forward and returns pointer to next data, or else NULL
@@ -42,13 +172,39 @@ byte *HistoryStack::GoFwd()
     
     Index++;
     
-    return &Stack[Index*Size];
+    // Redo this step
+    DataHistory.Redo(Steps[Index].Data,Current);
+    MaskHistory.Redo(Steps[Index].Masks,CurrentMasks);
+    
+    return &Current[0];
 }
 
 // Gets the currently-pointed-to data block
 byte *HistoryStack::GetBlock()
 {
-    if (Index*Size >= Stack.size()) return NULL;
+    Commit();
+    if (Steps.empty()) return NULL;
+    
+    return &Current[0];
+}
+
+
+// For adding the candidate masks of the latest step
+uint64_t *HistoryStack::AddMasks()
+{
+    Commit();
+    if (MaskSize == 0 || Steps.empty() || Index+1 != Steps.size() || Steps[Index].HasMasks) return NULL;
     
-    return &Stack[Index*Size];
-}
\ No newline at end of file
+    BaseMasks = CurrentMasks;
+    MasksPending = true;
+    return &CurrentMasks[0];
+}
+
+// Gets the current step's candidate masks
+uint64_t *HistoryStack::GetMasks()
+{
+    Commit();
+    if (Steps.empty() || !Steps[Index].HasMasks) return NULL;
+    
+    return &CurrentMasks[0];
+}
@@ -9,38 +9,121 @@
 #ifndef HistoryStack_hpp
 #define HistoryStack_hpp
 
+#include <stdint.h>
 #include <vector>
+#include <deque>
 using namespace std;
 
 typedef unsigned int uint;
 typedef unsigned char byte;
 
+// Stores each step as the items that changed in it, with their values before and after,
+// so going back and forward only touches those items.
+// A step that changes most of the block is stored as a full frame of both blocks instead,
+// since that is smaller.
+//
+// Each step can also have the candidates that solving it found, as bit masks,
+// so that going back and forward does not have to solve it again.
+// They are stored in the same way.
+
+// The changes and frames of one kind of item: the data blocks' bytes or the candidate masks
+template<class T, class IndexType> class HistoryTrack
+{
+    struct Change
+    {
+        IndexType Index;
+        T Prev, Next;
+    };
+    
+    // Deques, so that adding to them never copies the history
+    deque<Change> Changes;
+    deque<T> Frames;
+
+public:
+    // Where a step starts in Changes and in Frames, and its number of changes.
+    // A full frame has the block before, then the block after
+    struct Step
+    {
+        size_t ChangeBegin, FrameBegin, NumChanges;
+        bool IsFrame;
+    };
+    
+    // Stores the change from Base to Current
+    Step Store(const vector<T> &Base, const vector<T> &Current);
+    
+    // Drops this step and all the ones after it
+    void DropFrom(const Step &First);
+    
+    void Undo(const Step &Undone, vector<T> &Current);
+    void Redo(const Step &Redone, vector<T> &Current);
+};
+
 class HistoryStack
 {
     uint Size;
     uint Index;
     
-    vector<byte> Stack;
+    // The number of 64-bit candidate-mask words per step, 0 if they are not stored
+    uint MaskSize;
     
-public:
-    // Create with a block size that will stay fixed
-    HistoryStack(uint Size_);
+    // A board has at most 81*81 cells
+    typedef HistoryTrack<byte,uint16_t> DataTrack;
+    typedef HistoryTrack<uint64_t,uint32_t> MaskTrack;
+    
+    struct Step
+    {
+        DataTrack::Step Data;
+        MaskTrack::Step Masks;
+        bool HasMasks;
+    };
+    
+    deque<Step> Steps;
+    DataTrack DataHistory;
+    MaskTrack MaskHistory;
+    
+    // The block at the current step, and the one before the latest Add().
+    // The data written after Add() is stored as a step when the stack is next used.
+    // Likewise for the masks and AddMasks()
+    vector<byte> Current;
+    vector<byte> Base;
+    bool IsPending;
+    
+    vector<uint64_t> CurrentMasks;
+    vector<uint64_t> BaseMasks;
+    bool MasksPending;
+    
+    // Stores the pending data and masks, if there are any
+    void Commit();
 
+public:
+    // Create with a block size that will stay fixed, and optionally a candidate-mask size
+    HistoryStack(uint Size_, uint MaskSize_ = 0);
+    
     uint GetSize() {return Size;}
+    uint GetMaskSize() {return MaskSize;}
     
     // Index is zero-based
     bool CanGoBack() {return (Index > 0);}
     // Index ends at ((# data blocks) - 1)
-    bool CanGoFwd() {return (Stack.size() > (Index+1)*Size);}
+    bool CanGoFwd() {Commit(); return (Steps.size() > Index+1);}
     
-    // For adding data: returns a pointer to add the data to
+    // For adding data: returns a pointer to add the data to.
+    // It starts out as the current block.
     byte *Add();
     // Goes back and returns pointer to previous data, or else NULL
     byte *GoBack();
     // Goes forward and returns pointer to next data, or else NULL
     byte *GoFwd();
     // Gets the currently-pointed-to data block
+    // This and the previous two are for reading only
     byte *GetBlock();
+    
+    // For adding the candidate masks of the latest step, after solving it:
+    // returns a pointer to add them to, or else NULL if it already has them or there are none
+    uint64_t *AddMasks();
+    // Gets the current step's candidate masks, or else NULL if it does not have them
+    // This is for reading only
+    uint64_t *GetMasks();
 };
 
 #endif /* HistoryStack_hpp */
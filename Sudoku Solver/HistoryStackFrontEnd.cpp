@@ -26,11 +26,11 @@ HistoryStackFrontEnd::~HistoryStackFrontEnd()
     delete HSP;
 }
 
-void HistoryStackFrontEnd::SetSize(uint Size)
+void HistoryStackFrontEnd::SetSize(uint Size, uint MaskSize)
 {
     HistoryStack *HSP = (HistoryStack *)HistoryStackPtr;
     delete HSP;
-    HistoryStackPtr = new HistoryStack(Size);
+    HistoryStackPtr = new HistoryStack(Size,MaskSize);
 }
 
 uint HistoryStackFrontEnd::GetSize()
@@ -79,3 +79,16 @@ byte *HistoryStackFrontEnd::GetBlock()
     return HSP->GetBlock();
 }
 
+// For adding the latest step's candidate masks
+uint64_t *HistoryStackFrontEnd::AddMasks()
+{
+    HistoryStack *HSP = (HistoryStack *)HistoryStackPtr;
+    return HSP->AddMasks();
+}
+
+// Gets the current step's candidate masks
+uint64_t *HistoryStackFrontEnd::GetMasks()
+{
+    HistoryStack *HSP = (HistoryStack *)HistoryStackPtr;
+    return HSP->GetMasks();
+}
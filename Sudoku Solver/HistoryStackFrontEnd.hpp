@@ -9,6 +9,8 @@
 #ifndef HistoryStackFrontEnd_hpp
 #define HistoryStackFrontEnd_hpp
 
+#include <stdint.h>
+
 typedef unsigned int uint;
 typedef unsigned char byte;
 
@@ -21,7 +23,8 @@ public:
     HistoryStackFrontEnd();
     ~HistoryStackFrontEnd();
     
-    void SetSize(uint Size);
+    // Optionally with a size for each step's candidate masks
+    void SetSize(uint Size, uint MaskSize = 0);
     uint GetSize();
     
     bool CanGoBack();
@@ -35,6 +38,11 @@ public:
     byte *GoFwd();
     // Gets the currently-pointed-to data block
     byte *GetBlock();
+    
+    // For adding the latest step's candidate masks after solving it, or else NULL
+    uint64_t *AddMasks();
+    // Gets the current step's candidate masks, or else NULL
+    uint64_t *GetMasks();
 };
 
 #endif /* HistoryStackFrontEnd_hpp */
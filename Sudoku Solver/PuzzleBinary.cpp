@@ -0,0 +1,270 @@
+//
+//  PuzzleBinary.cpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+
+#include "PuzzleBinary.hpp"
+#include "SudokuConstants.h"
+#include <string.h>
+
+
+static const char HeaderMagic[4] = {'S','D','K','B'};
+static const char TrailerMagic[8] = {'S','D','K','B','E','N','D','\0'};
+static const uint Version = 1;
+static const size_t HeaderSize = 16, TrailerSize = 24;
+static const uint IndexStrideLog = 6;
+
+// Has a solution after the puzzle
+static const byte RecordHasSolution = 1;
+
+
+static uint BitsForSide(uint SideLength)
+{
+    uint Bits = 1;
+    while ((1U << Bits) < SideLength+1) Bits++;
+    return Bits;
+}
+
+static void PutUint64(byte *Dest, uint64_t Val)
+{
+    for (uint ib=0; ib<8; ib++)
+        Dest[ib] = (byte)(Val >> (8*ib));
+}
+
+static uint64_t GetUint64(const byte *Src)
+{
+    uint64_t Val = 0;
+    for (uint ib=0; ib<8; ib++)
+        Val |= (uint64_t)Src[ib] << (8*ib);
+    return Val;
+}
+
+
+bool IsPuzzleBinary(const char *Begin, const char *End)
+{
+    return ((size_t)(End - Begin) >= HeaderSize && memcmp(Begin,HeaderMagic,sizeof(HeaderMagic)) == 0);
+}
+
+
+PuzzleBinaryWriter::PuzzleBinaryWriter(FILE *File_, uint BlockRows_, uint BlockCols_)
+{
+    File = File_;
+    BlockRows = BlockRows_;
+    BlockCols = BlockCols_;
+    uint SideLength = BlockRows*BlockCols;
+    BoardSize = SideLength*SideLength;
+    BitsPerCell = BitsForSide(SideLength);
+    NumRecords = 0;
+    
+    byte Header[HeaderSize] = {0};
+    memcpy(Header,HeaderMagic,sizeof(HeaderMagic));
+    Header[4] = (byte)Version;
+    Header[5] = (byte)(Version >> 8);
+    Header[6] = (byte)BlockRows;
+    Header[7] = (byte)BlockCols;
+    Header[8] = (byte)BitsPerCell;
+    Header[9] = (byte)IndexStrideLog;
+    Buffer.assign(Header,Header+HeaderSize);
+    Offset = HeaderSize;
+}
+
+// Low bits first, padded to a whole byte
+void PuzzleBinaryWriter::Pack(const byte *Vals)
+{
+    uint64_t Bits = 0;
+    uint NumBits = 0;
+    for (uint ic=0; ic<BoardSize; ic++)
+    {
+        Bits |= (uint64_t)Vals[ic] << NumBits;
+        NumBits += BitsPerCell;
+        while (NumBits >= 8)
+        {
+            Buffer.push_back((byte)Bits);
+            Bits >>= 8;
+            NumBits -= 8;
+        }
+    }
+    if (NumBits > 0) Buffer.push_back((byte)Bits);
+}
+
+void PuzzleBinaryWriter::Flush()
+{
+    if (!Buffer.empty()) fwrite(&Buffer[0],1,Buffer.size(),File);
+    Buffer.clear();
+}
+
+void PuzzleBinaryWriter::Write(const byte *Vals, const byte *SolvedVals)
+{
+    if ((NumRecords & ((1U << IndexStrideLog) - 1)) == 0) Index.push_back(Offset);
+    NumRecords++;
+    
+    size_t Start = Buffer.size();
+    Buffer.push_back((SolvedVals != NULL) ? RecordHasSolution : 0);
+    Pack(Vals);
+    if (SolvedVals != NULL) Pack(SolvedVals);
+    Offset += Buffer.size() - Start;
+    
+    if (Buffer.size() >= (1 << 20)) Flush();
+}
+
+bool PuzzleBinaryWriter::Finish()
+{
+    uint64_t IndexOffset = Offset;
+    for (size_t ix=0; ix<Index.size(); ix++)
+    {
+        byte Entry[8];
+        PutUint64(Entry,Index[ix]);
+        Buffer.insert(Buffer.end(),Entry,Entry+8);
+    }
+    
+    byte Trailer[TrailerSize];
+    PutUint64(Trailer,IndexOffset);
+    PutUint64(Trailer+8,NumRecords);
+    memcpy(Trailer+16,TrailerMagic,sizeof(TrailerMagic));
+    Buffer.insert(Buffer.end(),Trailer,Trailer+TrailerSize);
+    
+    Flush();
+    return (fflush(File) == 0 && !ferror(File));
+}
+
+
+PuzzleBinaryReader::PuzzleBinaryReader()
+{
+    Begin = Pos = IndexBegin = NULL;
+    BlockRows = BlockCols = BoardSize = BitsPerCell = IndexStride = 0;
+    RecordBytes = NumRecords = NextRecord = 0;
+}
+
+bool PuzzleBinaryReader::Open(const char *Begin_, const char *End, string &Error_)
+{
+    Begin = (const byte *)Begin_;
+    size_t Size = End - Begin_;
+    if (Size < HeaderSize + TrailerSize)
+    {
+        Error_ = "not a complete binary puzzle file";
+        return false;
+    }
+    const byte *Header = Begin;
+    const byte *Trailer = Begin + Size - TrailerSize;
+    if (memcmp(Header,HeaderMagic,sizeof(HeaderMagic)) != 0 ||
+        memcmp(Trailer+16,TrailerMagic,sizeof(TrailerMagic)) != 0)
+    {
+        Error_ = "not a complete binary puzzle file";
+        return false;
+    }
+    uint FileVersion = Header[4] | (Header[5] << 8);
+    if (FileVersion != Version)
+    {
+        Error_ = "unknown binary puzzle file version";
+        return false;
+    }
+    
+    BlockRows = Header[6];
+    BlockCols = Header[7];
+    uint SideLength = BlockRows*BlockCols;
+    BoardSize = SideLength*SideLength;
+    BitsPerCell = Header[8];
+    IndexStride = 1U << Header[9];
+    if (BlockRows < MinBlockSize || BlockRows > MaxBlockSize ||
+        BlockCols < MinBlockSize || BlockCols > MaxBlockSize ||
+        BitsPerCell != BitsForSide(SideLength) || Header[9] > 30)
+    {
+        Error_ = "bad binary puzzle file header";
+        return false;
+    }
+    RecordBytes = (BoardSize*BitsPerCell + 7)/8;
+    
+    uint64_t IndexOffset = GetUint64(Trailer);
+    NumRecords = (size_t)GetUint64(Trailer+8);
+    size_t IndexSize = (NumRecords + IndexStride - 1)/IndexStride;
+    if (IndexOffset < HeaderSize || IndexOffset > Size - TrailerSize ||
+        8*IndexSize != Size - TrailerSize - IndexOffset || NumRecords > Size)
+    {
+        Error_ = "bad binary puzzle file index";
+        return false;
+    }
+    IndexBegin = Begin + IndexOffset;
+    
+    Error.clear();
+    return Seek(0);
+}
+
+bool PuzzleBinaryReader::Seek(size_t irec)
+{
+    if (irec > NumRecords) return false;
+    if (irec == NumRecords)
+    {
+        Pos = IndexBegin;
+        NextRecord = irec;
+        return true;
+    }
+    
+    // From the nearest indexed record, skip the ones before this one by their flags
+    size_t ix = irec/IndexStride;
+    uint64_t Offset = GetUint64(IndexBegin + 8*ix);
+    if (Offset < HeaderSize || Offset >= (uint64_t)(IndexBegin - Begin))
+    {
+        Error = "bad binary puzzle file index";
+        return false;
+    }
+    Pos = Begin + Offset;
+    for (NextRecord = ix*IndexStride; NextRecord < irec; NextRecord++)
+    {
+        if (Pos >= IndexBegin) return false;
+        Pos += 1 + ((Pos[0] & RecordHasSolution) ? 2 : 1)*RecordBytes;
+    }
+    return true;
+}
+
+bool PuzzleBinaryReader::Unpack(const byte *Packed, byte *Vals)
+{
+    uint SideLength = BlockRows*BlockCols;
+    uint Mask = (1U << BitsPerCell) - 1;
+    uint64_t Bits = 0;
+    uint NumBits = 0;
+    bool IsOK = true;
+    for (uint ic=0; ic<BoardSize; ic++)
+    {
+        while (NumBits < BitsPerCell)
+        {
+            Bits |= (uint64_t)*(Packed++) << NumBits;
+            NumBits += 8;
+        }
+        uint Value = Bits & Mask;
+        Bits >>= BitsPerCell;
+        NumBits -= BitsPerCell;
+        if (Value > SideLength) IsOK = false;
+        Vals[ic] = Value;
+    }
+    return IsOK;
+}
+
+bool PuzzleBinaryReader::Next(byte *Vals, byte *SolvedVals, bool *HasSolution)
+{
+    if (NextRecord >= NumRecords || HasError()) return false;
+    
+    bool IsSolved = (Pos[0] & RecordHasSolution) != 0;
+    size_t Size = 1 + (IsSolved ? 2 : 1)*RecordBytes;
+    if (Pos + Size > IndexBegin)
+    {
+        Error = "binary puzzle file records overrun the index";
+        return false;
+    }
+    
+    bool IsOK = Unpack(Pos+1,Vals);
+    if (IsSolved && SolvedVals != NULL) IsOK = Unpack(Pos+1+RecordBytes,SolvedVals) && IsOK;
+    if (!IsOK)
+    {
+        char Buffer[64];
+        snprintf(Buffer,sizeof(Buffer),"puzzle %zu: bad cell value",NextRecord+1);
+        Error = Buffer;
+        return false;
+    }
+    if (HasSolution != NULL) *HasSolution = IsSolved;
+    
+    Pos += Size;
+    NextRecord++;
+    return true;
+}
@@ -0,0 +1,104 @@
+//
+//  PuzzleBinary.hpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Compact binary container for puzzles and their solutions, for archiving many of them.
+// All the puzzles in one have the same block dimensions.
+//
+// Layout, with all numbers little-endian:
+//   header, 16 bytes: "SDKB", version (2 bytes), block rows, block columns,
+//     bits per cell, index stride (1 byte, as a power of 2), then 6 zero bytes
+//   records: a flags byte, bit 0 set if a solution follows,
+//     then the puzzle's cell values, row by row, and optionally the solution's,
+//     each packed into bits per cell = ceil(log2(side length + 1)), low bits first,
+//     and padded to a whole byte
+//   index: the 8-byte offset of every (index stride)-th record, starting with the first
+//   trailer, 24 bytes: index offset (8 bytes), number of records (8 bytes), "SDKBEND\0"
+//
+// So it can be written in one pass, even to a pipe, and read at any record:
+// the index gives the nearest earlier indexed record, and each record's flags give its size.
+//
+
+#ifndef PuzzleBinary_hpp
+#define PuzzleBinary_hpp
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+typedef unsigned char byte;
+typedef unsigned int uint;
+
+// Whether some data starts like one of these containers
+bool IsPuzzleBinary(const char *Begin, const char *End);
+
+class PuzzleBinaryWriter
+{
+    FILE *File;
+    uint BlockRows, BlockCols, BoardSize, BitsPerCell;
+    
+    uint64_t Offset, NumRecords;
+    vector<uint64_t> Index;
+    
+    // Output is collected here and written in big pieces
+    vector<byte> Buffer;
+    
+    void Pack(const byte *Vals);
+    void Flush();
+    
+    PuzzleBinaryWriter(const PuzzleBinaryWriter &) = delete;
+    PuzzleBinaryWriter &operator=(const PuzzleBinaryWriter &) = delete;
+
+public:
+    // Writes the header to an open file, which the caller closes after Finish()
+    PuzzleBinaryWriter(FILE *File_, uint BlockRows_, uint BlockCols_);
+    
+    uint GetBlockRows() {return BlockRows;}
+    uint GetBlockCols() {return BlockCols;}
+    
+    // Adds a puzzle, and its solution if that is not NULL
+    void Write(const byte *Vals, const byte *SolvedVals = NULL);
+    
+    // Writes the index and the trailer; returns false if writing failed
+    bool Finish();
+};
+
+class PuzzleBinaryReader
+{
+    const byte *Begin, *Pos, *IndexBegin;
+    uint BlockRows, BlockCols, BoardSize, BitsPerCell, IndexStride;
+    size_t RecordBytes, NumRecords, NextRecord;
+    string Error;
+    
+    // Returns false if a value is out of range
+    bool Unpack(const byte *Packed, byte *Vals);
+
+public:
+    PuzzleBinaryReader();
+    
+    // Checks the header and the trailer; returns false and sets Error if they are bad
+    bool Open(const char *Begin_, const char *End, string &Error);
+    
+    uint GetBlockRows() {return BlockRows;}
+    uint GetBlockCols() {return BlockCols;}
+    size_t GetNumRecords() {return NumRecords;}
+    
+    // Moves to a record, for reading it next
+    bool Seek(size_t irec);
+    
+    // Reads the next record's puzzle and, if SolvedVals is not NULL, its solution.
+    // HasSolution, if not NULL, gets whether it has one; if it has none, SolvedVals is left alone.
+    // Returns false at the end or if the record is bad
+    bool Next(byte *Vals, byte *SolvedVals = NULL, bool *HasSolution = NULL);
+    
+    // Whether it stopped because of a bad record, and why
+    bool HasError() {return !Error.empty();}
+    const string &GetError() {return Error;}
+};
+
+#endif /* PuzzleBinary_hpp */
@@ -0,0 +1,181 @@
+//
+//  PuzzleGenerator.cpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+
+#include "PuzzleGenerator.hpp"
+#include "BoardManager.hpp"
+#include "DancingLinks.hpp"
+#include <algorithm>
+#include <thread>
+
+
+PuzzleGenerator::PuzzleGenerator(uint BlockRows_, uint BlockCols_, uint64_t Seed):
+    Rng(Seed)
+{
+    BlockRows = BlockRows_;
+    BlockCols = BlockCols_;
+    SideLength = BlockRows*BlockCols;
+    BoardSize = SideLength*SideLength;
+    IsRequired = false;
+    MaxSearchNodes = DefaultMaxSearchNodes;
+    MakeCheckers(1);
+}
+
+PuzzleGenerator::~PuzzleGenerator()
+{
+    DeleteCheckers();
+}
+
+void PuzzleGenerator::MakeCheckers(uint NumThreads)
+{
+    DeleteCheckers();
+    if (NumThreads < 1) NumThreads = 1;
+    
+    Checkers.resize(NumThreads);
+    for (uint ith=0; ith<NumThreads; ith++)
+    {
+        Checker &C = Checkers[ith];
+        C.ExactCover = new DancingLinks(BlockRows,BlockCols);
+        C.ExactCover->SetMaxNodes(MaxSearchNodes);
+        C.Techniques = new BoardManager(BlockRows,BlockCols,Required);
+        C.Vals.resize(BoardSize);
+    }
+}
+
+void PuzzleGenerator::DeleteCheckers()
+{
+    for (size_t ith=0; ith<Checkers.size(); ith++)
+    {
+        delete Checkers[ith].ExactCover;
+        delete Checkers[ith].Techniques;
+    }
+    Checkers.clear();
+}
+
+void PuzzleGenerator::SetRequired(const SolverParameters &Params)
+{
+    Required = Params;
+    Required.UseSearch = false;
+    Required.UseExactCover = false;
+    IsRequired = true;
+    MakeCheckers((uint)Checkers.size());
+}
+
+void PuzzleGenerator::SetMaxSearchNodes(size_t MaxSearchNodes_)
+{
+    MaxSearchNodes = MaxSearchNodes_;
+    for (size_t ith=0; ith<Checkers.size(); ith++)
+        Checkers[ith].ExactCover->SetMaxNodes(MaxSearchNodes);
+}
+
+
+void PuzzleGenerator::MakeGrid(byte *Grid)
+{
+    // The diagonal blocks share no rows or columns, so any values in them are consistent.
+    // Fill them at random, then let exact cover fill the rest
+    DancingLinks &ExactCover = *Checkers[0].ExactCover;
+    ExactCover.SetMaxNodes(0);
+    vector<byte> Perm(SideLength);
+    for (uint iv=0; iv<SideLength; iv++)
+        Perm[iv] = iv+1;
+    
+    uint NumDiag = min(BlockRows,BlockCols);
+    do
+    {
+        fill(Grid,Grid+BoardSize,0);
+        for (uint ib=0; ib<NumDiag; ib++)
+        {
+            shuffle(Perm.begin(),Perm.end(),Rng);
+            for (uint ir=0; ir<BlockRows; ir++)
+                for (uint ic=0; ic<BlockCols; ic++)
+                    Grid[SideLength*(BlockRows*ib+ir) + BlockCols*ib+ic] = Perm[BlockCols*ir+ic];
+        }
+    }
+    while (ExactCover.Solve(Grid,1) == 0);
+    ExactCover.SetMaxNodes(MaxSearchNodes);
+    
+    // Exact cover tries values in a fixed order, so relabel them at random
+    shuffle(Perm.begin(),Perm.end(),Rng);
+    for (uint ic=0; ic<BoardSize; ic++)
+        Grid[ic] = Perm[Grid[ic]-1];
+}
+
+PuzzleGenerator::RemovalResult PuzzleGenerator::CanRemove(Checker &C, const vector<byte> &Vals, const vector<byte> &Grid, uint icell)
+{
+    C.Vals = Vals;
+    C.Vals[icell] = 0;
+    
+    // If the techniques solve it without search, it has only one solution
+    if (IsRequired)
+    {
+        C.Techniques->SetValues(&C.Vals[0]);
+        C.Techniques->SolveAndUpdate();
+        C.Techniques->GetValues(&C.Vals[0]);
+        return (find(C.Vals.begin(),C.Vals.end(),0) == C.Vals.end()) ? RemovalWorks : RemovalFails;
+    }
+    
+    if (C.ExactCover->SolveExcluding(&C.Vals[0],icell,Grid[icell],1) > 0) return RemovalFails;
+    return C.ExactCover->HitMaxNodes() ? RemovalUnknown : RemovalWorks;
+}
+
+void PuzzleGenerator::Generate(byte *Vals, byte *Solution)
+{
+    vector<byte> Grid(BoardSize);
+    MakeGrid(&Grid[0]);
+    if (Solution != NULL) copy(Grid.begin(),Grid.end(),Solution);
+    vector<byte> Puzzle = Grid;
+    
+    vector<uint> Order(BoardSize);
+    for (uint ic=0; ic<BoardSize; ic++)
+        Order[ic] = ic;
+    shuffle(Order.begin(),Order.end(),Rng);
+    
+    // Try the next cells in the order in a batch, one per thread, all against the same puzzle.
+    // Take the first removal that works. A cell whose removal failed keeps its value for good,
+    // since removing other values will not make it work. Those after the taken one
+    // whose removals did not fail must be tried again against the new puzzle, so they go back in the order.
+    // So the result is the same as trying each cell in turn
+    uint NumThreads = (uint)Checkers.size();
+    vector<uint> Batch;
+    vector<RemovalResult> Results(NumThreads);
+    vector<thread> Threads;
+    size_t Next = 0;
+    
+    while (Next < Order.size())
+    {
+        size_t NumBatch = min((size_t)NumThreads,Order.size()-Next);
+        Batch.assign(Order.begin()+Next,Order.begin()+Next+NumBatch);
+        
+        if (NumBatch == 1)
+            Results[0] = CanRemove(Checkers[0],Puzzle,Grid,Batch[0]);
+        else
+        {
+            Threads.clear();
+            for (size_t ib=1; ib<NumBatch; ib++)
+                Threads.push_back(thread([this,&Results,&Puzzle,&Grid,&Batch,ib]()
+                    {Results[ib] = CanRemove(Checkers[ib],Puzzle,Grid,Batch[ib]);}));
+            Results[0] = CanRemove(Checkers[0],Puzzle,Grid,Batch[0]);
+            for (size_t ith=0; ith<Threads.size(); ith++)
+                Threads[ith].join();
+        }
+        
+        size_t ib = 0;
+        while (ib < NumBatch && Results[ib] != RemovalWorks) ib++;
+        if (ib == NumBatch)
+        {
+            Next += NumBatch;
+            continue;
+        }
+        
+        Puzzle[Batch[ib]] = 0;
+        size_t NewNext = Next + NumBatch;
+        for (size_t ir=NumBatch; ir>ib+1; ir--)
+            if (Results[ir-1] != RemovalFails) Order[--NewNext] = Batch[ir-1];
+        Next = NewNext;
+    }
+    
+    copy(Puzzle.begin(),Puzzle.end(),Vals);
+}
@@ -0,0 +1,98 @@
+//
+//  PuzzleGenerator.hpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Makes puzzles with unique solutions.
+// It makes a random full grid, then tries removing each of its values in random order,
+// keeping a removal only if the puzzle still has only one solution, and optionally,
+// only if a board manager's solution techniques can still solve it with some solver parameters.
+// Exact cover checks for a solution with some other value in the removed cell,
+// which is much faster than counting solutions, since it need not find the grid again.
+// A few of those checks take far longer than the rest, so each one has a limit on its search,
+// and a removal whose check reaches it is not made. So the puzzles may not be quite minimal.
+//
+// Removals can be tried on several threads at once. Removing more values never makes
+// a removal that failed work, so the result is the same as trying them one at a time,
+// and it depends only on the seed.
+//
+
+#ifndef PuzzleGenerator_hpp
+#define PuzzleGenerator_hpp
+
+#include "SolverParameters.h"
+
+#include <stdint.h>
+#include <vector>
+#include <random>
+using namespace std;
+
+typedef unsigned char byte;
+typedef unsigned int uint;
+
+class BoardManager;
+class DancingLinks;
+
+class PuzzleGenerator
+{
+    uint BlockRows, BlockCols, SideLength, BoardSize;
+    
+    mt19937_64 Rng;
+    
+    bool IsRequired;
+    SolverParameters Required;
+    
+    size_t MaxSearchNodes;
+    
+    // One of each for each removal thread
+    struct Checker
+    {
+        DancingLinks *ExactCover;
+        BoardManager *Techniques;
+        vector<byte> Vals;
+    };
+    vector<Checker> Checkers;
+    
+    void MakeCheckers(uint NumThreads);
+    void DeleteCheckers();
+    
+    // Whether the puzzle is still good without that cell's value, with Grid being its solution.
+    // Unknown if the check stopped at the search-node limit
+    enum RemovalResult {RemovalFails, RemovalWorks, RemovalUnknown};
+    RemovalResult CanRemove(Checker &C, const vector<byte> &Vals, const vector<byte> &Grid, uint icell);
+    
+    PuzzleGenerator(const PuzzleGenerator &) = delete;
+    PuzzleGenerator &operator=(const PuzzleGenerator &) = delete;
+
+public:
+    PuzzleGenerator(uint BlockRows_, uint BlockCols_, uint64_t Seed);
+    ~PuzzleGenerator();
+    
+    uint GetBoardSize() {return BoardSize;}
+    
+    // Start over with another seed
+    void SetSeed(uint64_t Seed) {Rng.seed(Seed);}
+    
+    // Require that the techniques solve the puzzles with these parameters, without search
+    void SetRequired(const SolverParameters &Params);
+    void ClearRequired() {IsRequired = false;}
+    
+    // The number of threads for trying removals; 1 by default
+    void SetRemovalThreads(uint NumThreads) {MakeCheckers(NumThreads);}
+    
+    // The limit on each removal check's search nodes, with 0 being none; 0 makes minimal puzzles.
+    // The default is far more than 9*9 checks need, and it makes 16*16 puzzles several times faster
+    // with only a few more values than minimal ones
+    static const size_t DefaultMaxSearchNodes = 10000;
+    void SetMaxSearchNodes(size_t MaxSearchNodes_);
+    size_t GetMaxSearchNodes() {return MaxSearchNodes;}
+    
+    // A random full grid, in BoardSize values, row by row
+    void MakeGrid(byte *Grid);
+    
+    // A puzzle, and optionally its solution, in BoardSize values each
+    void Generate(byte *Vals, byte *Solution = NULL);
+};
+
+#endif /* PuzzleGenerator_hpp */
@@ -0,0 +1,357 @@
+//
+//  PuzzleReader.cpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+
+#include "PuzzleReader.hpp"
+#include "SudokuConstants.h"
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+
+int PuzzleCharToValue(int c)
+{
+    if (c == '.' || c == '0') return 0;
+    if (c >= '1' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'z') return c - 'a' + 10;
+    return -1;
+}
+
+char PuzzleValueToChar(uint Val)
+{
+    if (Val == 0) return '.';
+    if (Val <= 9) return (char)('0' + Val);
+    if (Val <= MaxLineValue) return (char)('A' + Val - 10);
+    return 0;
+}
+
+
+// Block dimensions for a side length: as nearly square as possible, with more columns than rows
+static bool BlockDimsForSide(uint SideLength, uint &BlockRows, uint &BlockCols)
+{
+    for (uint br=1; br*br<=SideLength; br++)
+    {
+        if (SideLength % br != 0) continue;
+        BlockRows = br;
+        BlockCols = SideLength/br;
+    }
+    return (BlockRows <= MaxBlockSize && BlockCols <= MaxBlockSize);
+}
+
+inline bool IsSpace(char c) {return (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v');}
+
+// Line-format characters' values, so that each one takes only a lookup:
+// -1 for a bad one and LineSpace for the spacing that is skipped
+enum {LineSpace = -2};
+
+struct LineCharTable
+{
+    signed char Values[256];
+    
+    LineCharTable()
+    {
+        for (int c=0; c<256; c++)
+            Values[c] = PuzzleCharToValue(c);
+        Values[(byte)' '] = Values[(byte)'\t'] = Values[(byte)'\r'] = LineSpace;
+    }
+};
+
+static const LineCharTable LineChars;
+
+
+bool PuzzleMap::Open(const char *FileName, string &Error)
+{
+    Close();
+    
+    int fd = open(FileName,O_RDONLY);
+    if (fd < 0)
+    {
+        Error = strerror(errno);
+        return false;
+    }
+    
+    // Map a regular file; read anything else
+    struct stat Stat;
+    if (fstat(fd,&Stat) == 0 && S_ISREG(Stat.st_mode) && Stat.st_size > 0)
+    {
+        void *Mapped = mmap(NULL,(size_t)Stat.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+        if (Mapped != MAP_FAILED)
+        {
+            madvise(Mapped,(size_t)Stat.st_size,MADV_SEQUENTIAL);
+            close(fd);
+            Data = (const char *)Mapped;
+            Size = (size_t)Stat.st_size;
+            IsMapped = true;
+            return true;
+        }
+    }
+    
+    FILE *f = fdopen(fd,"r");
+    if (f == NULL)
+    {
+        Error = strerror(errno);
+        close(fd);
+        return false;
+    }
+    bool IsOK = Read(f,Error);
+    fclose(f);
+    return IsOK;
+}
+
+bool PuzzleMap::Read(FILE *f, string &Error)
+{
+    Close();
+    
+    const size_t ChunkSize = 1 << 20;
+    size_t Used = 0;
+    while (true)
+    {
+        Buffer.resize(Used + ChunkSize);
+        size_t NumRead = fread(&Buffer[Used],1,ChunkSize,f);
+        Used += NumRead;
+        if (NumRead < ChunkSize) break;
+    }
+    Buffer.resize(Used);
+    if (ferror(f))
+    {
+        Error = strerror(errno);
+        Buffer.clear();
+        return false;
+    }
+    
+    Data = Buffer.data();
+    Size = Used;
+    return true;
+}
+
+void PuzzleMap::Close()
+{
+    if (IsMapped) munmap((void *)Data,Size);
+    IsMapped = false;
+    Buffer.clear();
+    Data = NULL;
+    Size = 0;
+}
+
+
+PuzzleScanner::PuzzleScanner(const char *Begin, const char *End_, PuzzleFormat Format_,
+                             uint BlockRows_, uint BlockCols_)
+{
+    Pos = Begin;
+    End = End_;
+    Format = (Format_ == PuzzleFormatAuto) ? GuessPuzzleFormat(Begin,End) : Format_;
+    LineBlockRows = BlockRows_;
+    LineBlockCols = BlockCols_;
+    BlockRows = BlockCols = 0;
+    LineEnd = Pos;
+    NumRead = 0;
+    
+    if (Format == PuzzleFormatBinary && !Binary.Open(Begin,End,Error))
+        Error = "puzzle 1: " + Error;
+}
+
+void PuzzleScanner::SetError(const char *Msg, uint Val1, uint Val2)
+{
+    char Buffer[128];
+    int Len = snprintf(Buffer,sizeof(Buffer),"puzzle %zu: ",NumRead+1);
+    snprintf(Buffer+Len,sizeof(Buffer)-Len,Msg,Val1,Val2);
+    Error = Buffer;
+}
+
+// Skips whitespace, then reads decimal digits; too big a number becomes one that is out of range
+bool PuzzleScanner::ScanUint(uint &Value)
+{
+    while (Pos < End && IsSpace(*Pos)) Pos++;
+    if (Pos >= End || *Pos < '0' || *Pos > '9') return false;
+    
+    uint Val = 0;
+    while (Pos < End && *Pos >= '0' && *Pos <= '9')
+    {
+        if (Val < 100000000) Val = 10*Val + (*Pos - '0');
+        Pos++;
+    }
+    Value = Val;
+    return true;
+}
+
+
+bool PuzzleScanner::NextSize(uint &BlockRows_, uint &BlockCols_)
+{
+    if (HasError()) return false;
+    
+    if (Format == PuzzleFormatBinary)
+    {
+        if (NumRead >= Binary.GetNumRecords()) return false;
+        BlockRows = Binary.GetBlockRows();
+        BlockCols = Binary.GetBlockCols();
+    }
+    else if (Format == PuzzleFormatText)
+    {
+        while (Pos < End && IsSpace(*Pos)) Pos++;
+        if (Pos >= End) return false;
+        
+        uint br = 0, bc = 0;
+        if (!ScanUint(br) || !ScanUint(bc) ||
+            br < MinBlockSize || br > MaxBlockSize || bc < MinBlockSize || bc > MaxBlockSize)
+        {
+            SetError("bad block dimensions %u %u",br,bc);
+            return false;
+        }
+        BlockRows = br;
+        BlockCols = bc;
+    }
+    else
+    {
+        // Skip empty lines
+        uint Length;
+        while (true)
+        {
+            if (Pos >= End) return false;
+            LineEnd = (const char *)memchr(Pos,'\n',End-Pos);
+            if (LineEnd == NULL) LineEnd = End;
+            
+            Length = 0;
+            for (const char *c=Pos; c<LineEnd; c++)
+                if (LineChars.Values[(byte)*c] != LineSpace) Length++;
+            if (Length > 0) break;
+            Pos = (LineEnd < End) ? LineEnd+1 : End;
+        }
+        
+        BlockRows = LineBlockRows;
+        BlockCols = LineBlockCols;
+        if (BlockRows == 0)
+        {
+            uint SideLength = 0;
+            while ((SideLength+1)*(SideLength+1) <= Length) SideLength++;
+            if (SideLength*SideLength != Length || !BlockDimsForSide(SideLength,BlockRows,BlockCols))
+            {
+                SetError("bad line length %u",Length);
+                return false;
+            }
+        }
+        uint SideLength = BlockRows*BlockCols;
+        if (Length != SideLength*SideLength)
+        {
+            SetError("bad line length %u",Length);
+            return false;
+        }
+    }
+    
+    BlockRows_ = BlockRows;
+    BlockCols_ = BlockCols;
+    return true;
+}
+
+bool PuzzleScanner::ReadVals(byte *Vals)
+{
+    uint SideLength = BlockRows*BlockCols;
+    uint BoardSize = SideLength*SideLength;
+    
+    if (Format == PuzzleFormatBinary)
+    {
+        if (!Binary.Next(Vals))
+        {
+            Error = Binary.GetError();
+            if (Error.empty()) Error = "binary puzzle file ends early";
+            return false;
+        }
+    }
+    else if (Format == PuzzleFormatText)
+    {
+        for (uint ic=0; ic<BoardSize; ic++)
+        {
+            uint Value;
+            if (!ScanUint(Value) || Value > SideLength)
+            {
+                SetError("bad cell value");
+                return false;
+            }
+            Vals[ic] = Value;
+        }
+    }
+    else
+    {
+        for (; Pos<LineEnd; Pos++)
+        {
+            int Value = LineChars.Values[(byte)*Pos];
+            if (Value == LineSpace) continue;
+            if (Value < 0 || Value > (int)SideLength)
+            {
+                SetError("bad cell '%c'",(uint)(byte)*Pos);
+                return false;
+            }
+            *(Vals++) = Value;
+        }
+        Pos = (LineEnd < End) ? LineEnd+1 : End;
+    }
+    
+    NumRead++;
+    return true;
+}
+
+bool PuzzleScanner::Next(Puzzle &P)
+{
+    if (!NextSize(P.BlockRows,P.BlockCols)) return false;
+    uint SideLength = P.BlockRows*P.BlockCols;
+    P.Vals.resize(SideLength*SideLength);
+    return ReadVals(&P.Vals[0]);
+}
+
+
+PuzzleFormat GuessPuzzleFormat(const char *Begin, const char *End)
+{
+    if (IsPuzzleBinary(Begin,End)) return PuzzleFormatBinary;
+    
+    bool InToken = false, AfterToken = false;
+    for (const char *Pos=Begin; Pos<End; Pos++)
+    {
+        char c = *Pos;
+        if (c == ' ' || c == '\t')
+        {
+            if (InToken) AfterToken = true;
+            InToken = false;
+        }
+        else if (c == '\n' || c == '\r')
+        {
+            if (InToken || AfterToken) break;
+        }
+        else
+        {
+            if (AfterToken) return PuzzleFormatText;
+            InToken = true;
+        }
+    }
+    return PuzzleFormatLine;
+}
+
+
+bool ReadPuzzles(const char *Begin, const char *End, PuzzleFormat Format, uint BlockRows, uint BlockCols,
+                 vector<Puzzle> &Puzzles, string &Error)
+{
+    PuzzleScanner Scanner(Begin,End,Format,BlockRows,BlockCols);
+    Puzzle P;
+    while (Scanner.Next(P))
+        Puzzles.push_back(P);
+    
+    if (Scanner.HasError())
+    {
+        Error = Scanner.GetError();
+        return false;
+    }
+    return true;
+}
+
+bool ReadPuzzles(FILE *f, PuzzleFormat Format, uint BlockRows, uint BlockCols,
+                 vector<Puzzle> &Puzzles, string &Error)
+{
+    PuzzleMap Contents;
+    if (!Contents.Read(f,Error)) return false;
+    return ReadPuzzles(Contents.Begin(),Contents.End(),Format,BlockRows,BlockCols,Puzzles,Error);
+}
@@ -0,0 +1,128 @@
+//
+//  PuzzleReader.hpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Reads many puzzles from a file, for the batch solver and the benchmark.
+//
+// Formats:
+//   text: the app's file format, repeated: block rows, block columns, then the cell values
+//   line: one puzzle per line, one character per cell: 1-9, then A-Z for 10 and up,
+//         and . or 0 for empty cells
+//   binary: PuzzleBinary's container, whose puzzles are read without their solutions
+//
+// A file is memory-mapped and parsed in place, one puzzle at a time,
+// so that reading a big corpus costs little more than touching its bytes.
+//
+
+#ifndef PuzzleReader_hpp
+#define PuzzleReader_hpp
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "PuzzleBinary.hpp"
+using namespace std;
+
+typedef unsigned char byte;
+typedef unsigned int uint;
+
+enum PuzzleFormat {PuzzleFormatAuto, PuzzleFormatText, PuzzleFormatLine, PuzzleFormatBinary};
+
+struct Puzzle
+{
+    uint BlockRows, BlockCols;
+    // Row by row, with 0 for empty cells
+    vector<byte> Vals;
+};
+
+// A whole file's contents: memory-mapped if possible, otherwise read into a buffer,
+// as for standard input
+class PuzzleMap
+{
+    const char *Data;
+    size_t Size;
+    bool IsMapped;
+    vector<char> Buffer;
+    
+    PuzzleMap(const PuzzleMap &) = delete;
+    PuzzleMap &operator=(const PuzzleMap &) = delete;
+
+public:
+    PuzzleMap(): Data(NULL), Size(0), IsMapped(false) {}
+    ~PuzzleMap() {Close();}
+    
+    // Return false and set Error if they fail
+    bool Open(const char *FileName, string &Error);
+    bool Read(FILE *f, string &Error);
+    void Close();
+    
+    const char *Begin() {return Data;}
+    const char *End() {return Data + Size;}
+};
+
+// Parses puzzles in place, one at a time, into the caller's buffers
+class PuzzleScanner
+{
+    const char *Pos, *End;
+    PuzzleFormat Format;
+    uint LineBlockRows, LineBlockCols;
+    
+    // The puzzle whose size was found and whose values are next
+    uint BlockRows, BlockCols;
+    const char *LineEnd;
+    
+    PuzzleBinaryReader Binary;
+    
+    size_t NumRead;
+    string Error;
+    
+    bool ScanUint(uint &Value);
+    void SetError(const char *Msg, uint Val1 = 0, uint Val2 = 0);
+
+public:
+    // Line-format puzzles have block dimensions BlockRows x BlockCols, or if those are 0,
+    // ones that fit the line length. Auto format guesses it
+    PuzzleScanner(const char *Begin, const char *End_, PuzzleFormat Format_,
+                  uint BlockRows_ = 0, uint BlockCols_ = 0);
+    
+    PuzzleFormat GetFormat() {return Format;}
+    
+    // Finds the next puzzle's block dimensions, for sizing a buffer for it.
+    // Returns false at the end or if there is a bad one
+    bool NextSize(uint &BlockRows_, uint &BlockCols_);
+    // Then reads its values into BlockRows*BlockCols*BlockRows*BlockCols bytes
+    bool ReadVals(byte *Vals);
+    
+    // Both of those, reusing the puzzle's buffer if it is big enough
+    bool Next(Puzzle &P);
+    
+    // Whether it stopped because of a bad puzzle, and why
+    bool HasError() {return !Error.empty();}
+    const string &GetError() {return Error;}
+    
+    // The number of complete puzzles read so far
+    size_t GetNumRead() {return NumRead;}
+};
+
+// Looks at the start: binary format starts with its header,
+// text format with two numbers, line format with one long token
+PuzzleFormat GuessPuzzleFormat(const char *Begin, const char *End);
+
+// Appends all the puzzles to Puzzles, as PuzzleScanner finds them.
+// Returns false and sets Error if there is a bad one
+bool ReadPuzzles(const char *Begin, const char *End, PuzzleFormat Format, uint BlockRows, uint BlockCols,
+                 vector<Puzzle> &Puzzles, string &Error);
+bool ReadPuzzles(FILE *f, PuzzleFormat Format, uint BlockRows, uint BlockCols,
+                 vector<Puzzle> &Puzzles, string &Error);
+
+// Cell characters for the line format; CharToValue returns -1 for a bad one.
+// The format has characters only for values up to MaxLineValue, so it cannot hold boards with longer sides,
+// and ValueToChar returns 0 for bigger values
+const uint MaxLineValue = 35;
+int PuzzleCharToValue(int c);
+char PuzzleValueToChar(uint Val);
+
+#endif /* PuzzleReader_hpp */
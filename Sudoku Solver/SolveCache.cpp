@@ -0,0 +1,122 @@
+//
+//  SolveCache.cpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+
+#include "SolveCache.hpp"
+#include <algorithm>
+
+
+SolveCache::SolveCache(size_t MaxBytes_)
+{
+    MaxBytes = MaxBytes_;
+}
+
+
+void SolveCache::MakeKey(uint BlockRows, uint BlockCols, const SolverParameters &Params,
+                         const byte *Vals, size_t BoardSize, string &Key)
+{
+    // Each parameter separately, so that structure padding does not get into the key.
+    // The number of search threads changes only which solution is found first, so it is left out
+    uint Header[] = {BlockRows, BlockCols, Params.MaxVisibleSetSize, Params.MaxHiddenSetSize,
+        Params.UseIntersections, Params.MaxFishSize, Params.UseXYWing, Params.UseXYZWing, Params.UseColoring,
+        Params.UseSearch, Params.SearchSetSize, Params.UseExactCover};
+    
+    Key.clear();
+    Key.reserve(sizeof(Header) + BoardSize);
+    Key.append((const char *)Header,sizeof(Header));
+    Key.append((const char *)Vals,BoardSize);
+}
+
+
+// The entry, its key, and roughly what the list node and index node take
+size_t SolveCache::EntryBytes(const string &Key, size_t NumMasks)
+{
+    return sizeof(Entry) + sizeof(string) + 6*sizeof(void *) + Key.size() + NumMasks*sizeof(uint64_t);
+}
+
+// Drops the least-recently-used results until the cache is within its bound
+void SolveCache::Evict()
+{
+    while (Counts.Bytes > MaxBytes && !Entries.empty())
+    {
+        Entry &Oldest = Entries.back();
+        Counts.Bytes -= EntryBytes(*Oldest.Key,Oldest.Masks.size());
+        Index.erase(*Oldest.Key);
+        Entries.pop_back();
+        Counts.Entries--;
+        Counts.Evictions++;
+    }
+}
+
+
+bool SolveCache::Find(const string &Key, uint64_t *Masks, size_t NumMasks)
+{
+    lock_guard<mutex> Guard(Lock);
+    
+    auto Found = Index.find(Key);
+    if (Found == Index.end() || Found->second->Masks.size() != NumMasks)
+    {
+        Counts.Misses++;
+        return false;
+    }
+    Counts.Hits++;
+    
+    // Now the most recently used
+    Entries.splice(Entries.begin(),Entries,Found->second);
+    copy(Found->second->Masks.begin(),Found->second->Masks.end(),Masks);
+    return true;
+}
+
+void SolveCache::Add(const string &Key, const uint64_t *Masks, size_t NumMasks)
+{
+    size_t Bytes = EntryBytes(Key,NumMasks);
+    
+    lock_guard<mutex> Guard(Lock);
+    
+    // Too big to keep at all
+    if (Bytes > MaxBytes) return;
+    
+    // Another thread may have added it since it was not found
+    if (Index.find(Key) != Index.end()) return;
+    
+    Entries.push_front(Entry());
+    auto Added = Index.insert(make_pair(Key,Entries.begin())).first;
+    Entry &NewEntry = Entries.front();
+    NewEntry.Key = &Added->first;
+    NewEntry.Masks.assign(Masks,Masks+NumMasks);
+    
+    Counts.Entries++;
+    Counts.Bytes += Bytes;
+    Evict();
+}
+
+
+size_t SolveCache::GetMaxBytes()
+{
+    lock_guard<mutex> Guard(Lock);
+    return MaxBytes;
+}
+
+void SolveCache::SetMaxBytes(size_t MaxBytes_)
+{
+    lock_guard<mutex> Guard(Lock);
+    MaxBytes = MaxBytes_;
+    Evict();
+}
+
+SolveCacheCounts SolveCache::GetCounts()
+{
+    lock_guard<mutex> Guard(Lock);
+    return Counts;
+}
+
+void SolveCache::Clear()
+{
+    lock_guard<mutex> Guard(Lock);
+    Entries.clear();
+    Index.clear();
+    Counts = SolveCacheCounts();
+}
@@ -0,0 +1,89 @@
+//
+//  SolveCache.hpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Cache of solve results, for when the same puzzles are solved over and over.
+// It is keyed by the block dimensions, the solver parameters, and the values before solving,
+// and it keeps the candidates after solving, from which the solved values follow.
+// The whole key is kept and compared, so a hash collision can never give the wrong result.
+// When it is over its memory bound, it drops the least-recently-used results.
+// It can be shared by board managers in different threads.
+
+#ifndef SolveCache_hpp
+#define SolveCache_hpp
+
+#include "SolverParameters.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+using namespace std;
+
+typedef unsigned char byte;
+typedef unsigned int uint;
+
+struct SolveCacheCounts
+{
+    unsigned long long Hits, Misses, Evictions;
+    
+    // Results kept, and their approximate memory use in bytes
+    size_t Entries, Bytes;
+    
+    SolveCacheCounts(): Hits(0), Misses(0), Evictions(0), Entries(0), Bytes(0) {}
+};
+
+class SolveCache
+{
+    struct Entry
+    {
+        // In the index, which does not move its keys
+        const string *Key;
+        vector<uint64_t> Masks;
+    };
+    
+    // Most recently used first
+    list<Entry> Entries;
+    unordered_map< string, list<Entry>::iterator > Index;
+    
+    size_t MaxBytes;
+    SolveCacheCounts Counts;
+    
+    mutex Lock;
+    
+    size_t EntryBytes(const string &Key, size_t NumMasks);
+    void Evict();
+    
+    SolveCache(const SolveCache &) = delete;
+    SolveCache &operator=(const SolveCache &) = delete;
+
+public:
+    // Create with a memory bound in bytes
+    SolveCache(size_t MaxBytes_);
+    
+    // Makes the key for a board before solving it
+    static void MakeKey(uint BlockRows, uint BlockCols, const SolverParameters &Params,
+                        const byte *Vals, size_t BoardSize, string &Key);
+    
+    // Returns whether it has the result; if so, it copies the candidates to Masks
+    bool Find(const string &Key, uint64_t *Masks, size_t NumMasks);
+    
+    // Keeps a result, as a copy of the candidates
+    void Add(const string &Key, const uint64_t *Masks, size_t NumMasks);
+    
+    // Changing the bound drops results until the cache is within it
+    size_t GetMaxBytes();
+    void SetMaxBytes(size_t MaxBytes_);
+    
+    SolveCacheCounts GetCounts();
+    
+    // Drops all the results and zeroes the counts
+    void Clear();
+};
+
+#endif /* SolveCache_hpp */
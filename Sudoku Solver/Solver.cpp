@@ -9,121 +9,1206 @@
 #include "Solver.hpp"
 #include "BooleanVecOps.hpp"
 #include <vector>
+#include <deque>
 #include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#if SOLVER_STATS
+#include <chrono>
+#endif
 
 
-static uint VectorSum(byte *Vec, uint IndMin, uint IndMax);
+// The techniques, for keeping track of which groups each one has checked:
+// the intersections, the wings and coloring, then the visible and hidden sets of each size, starting with 1,
+// then the row and column fish of each size, starting with 2.
+// The wings, coloring, and fish look at the whole board, so they use only the first group's entry
 
-typedef bool (*DistRCBFunc)(byte **, uint);
-static bool DistribRowColBlk(BoardManager &Board, DistRCBFunc Func, bool DoneIfOnce = true);
+enum
+{
+    TechItscBlkRow, TechItscBlkCol,
+    TechXYWing, TechXYZWing, TechColoring,
+    TechSetBase
+};
 
-static bool VisOne(byte **Avail, uint Size);
-static bool VisTwo(byte **Avail, uint Size);
-static bool VisThree(byte **Avail, uint Size);
-static bool VisFour(byte **Avail, uint Size);
-static bool VisFive(byte **Avail, uint Size);
+static uint TechVisSet(uint SetSize) {return TechSetBase + 2*(SetSize-1);}
+static uint TechHidSet(uint SetSize) {return TechSetBase + 2*(SetSize-1) + 1;}
 
-static bool HidOne(byte **Avail, uint Size);
-static bool HidTwo(byte **Avail, uint Size);
-static bool HidThree(byte **Avail, uint Size);
-static bool HidFour(byte **Avail, uint Size);
-static bool HidFive(byte **Avail, uint Size);
+// The fish come after all the sets, so they need the biggest set size
+static uint TechFishBase(uint MaxSetSize) {return TechHidSet(MaxSetSize) + 1;}
+static uint TechFish(uint MaxSetSize, uint FishSize, bool IsCols)
+{return TechFishBase(MaxSetSize) + 2*(FishSize-2) + (IsCols ? 1 : 0);}
 
-static bool ItscBlkRow(BoardManager &Board);
-static bool ItscBlkCol(BoardManager &Board);
-static bool Itsc(BoardManager &Board);
+#if SOLVER_STATS
+// The technique's name in the statistics
+static string TechName(uint itech, uint MaxSetSize)
+{
+    if (itech == TechItscBlkRow) return "ItscBlkRow";
+    if (itech == TechItscBlkCol) return "ItscBlkCol";
+    if (itech == TechXYWing) return "XYWing";
+    if (itech == TechXYZWing) return "XYZWing";
+    if (itech == TechColoring) return "Coloring";
+    if (itech >= TechFishBase(MaxSetSize))
+    {
+        uint FishIndex = itech - TechFishBase(MaxSetSize);
+        return ((FishIndex % 2 == 0) ? "FishRow" : "FishCol") + to_string(FishIndex/2 + 2);
+    }
+    uint SetSize = (itech - TechSetBase)/2 + 1;
+    return (((itech - TechSetBase) % 2 == 0) ? "Vis" : "Hid") + to_string(SetSize);
+}
+#endif
 
+// The state of the board in a search
 
-void Solve(BoardManager &Board, SolverParameters &Params)
+enum
 {
-next:
-    if (Params.MaxVisibleSetSize >= 1 && DistribRowColBlk(Board,VisOne,false)) goto next;
-    if (Params.MaxHiddenSetSize >= 1 && DistribRowColBlk(Board,HidOne)) goto next;
+    BoardBad,       // Some cell has no candidates or some group is missing some value
+    BoardOpen,      // Some cell has more than one candidate
+    BoardSolved     // Every cell has one candidate
+};
+
+
+// Index tables for a board geometry, made once per solver and shared by its copies,
+// so that the techniques can look up cells instead of working out their indices
+
+// The strip-block intersections for one kind of strip, ordered by block, then by strip.
+// For each one, the cells are those in both, then the rest of the strip, then the rest of the block
+struct IntersectionTable
+{
+    uint SegLength;         // Cells in both the strip and the block
+    uint NumPerBlock;       // Strips through each block
+    uint Stride;            // Cells per intersection: 2*SideLength - SegLength
+    vector<uint> StripGroups, BlockGroups;
+    vector<uint> Cells;
+};
+
+struct BoardTables
+{
+    uint SideLength, NumPeers;
     
-    if (Params.MaxVisibleSetSize >= 2 && DistribRowColBlk(Board,VisTwo)) goto next;
-    if (Params.MaxHiddenSetSize >= 2 && DistribRowColBlk(Board,HidTwo)) goto next;
+    // The cells of each group, SideLength of them per group
+    vector<uint> GroupCells;
+    // The row, column, and block groups of each cell
+    vector<uint> CellGroups;
+    // The other cells that share some group with each cell, in order, NumPeers of them per cell
+    vector<uint> Peers;
+    // The row-block and column-block intersections
+    IntersectionTable RowItsc, ColItsc;
     
-    if (Params.MaxVisibleSetSize >= 3 && DistribRowColBlk(Board,VisThree)) goto next;
-    if (Params.MaxHiddenSetSize >= 3 && DistribRowColBlk(Board,HidThree)) goto next;
+    BoardTables(uint BlockRows, uint BlockCols);
+};
+
+
+// For a search split across threads: shared by the workers, each with its own copy of the solver.
+// A task is a subtree of the search, given by the candidates at its root.
+// Each worker has a deque of tasks: it takes from the back, for depth-first order,
+// and idle workers steal from the front, where the tasks are nearest the root and so the biggest.
+
+template<class BV> struct SearchTaskQueue
+{
+    mutex Lock;
+    deque< vector<BV> > Tasks;
+    // For checking for tasks without locking
+    atomic<size_t> NumTasks;
     
-    if (Params.MaxVisibleSetSize >= 4 && DistribRowColBlk(Board,VisFour)) goto next;
-    if (Params.MaxHiddenSetSize >= 4 && DistribRowColBlk(Board,HidFour)) goto next;
+    SearchTaskQueue(): NumTasks(0) {}
+};
+
+template<class BV> struct ParallelSearch
+{
+    vector< SearchTaskQueue<BV> > Queues;
     
-    if (Params.MaxVisibleSetSize >= 5 && DistribRowColBlk(Board,VisFive)) goto next;
-    if (Params.MaxHiddenSetSize >= 5 && DistribRowColBlk(Board,HidFive)) goto next;
+    // Tasks queued or being worked on; the search is over when this gets to 0
+    atomic<size_t> PendingTasks;
+    // Workers looking for tasks
+    atomic<uint> NumIdle;
+    // Set when the search has found all the solutions it is looking for
+    atomic<bool> Done;
     
-    if (Params.UseIntersections && Itsc(Board)) goto next;
+    // For idle workers to sleep on when spinning finds no tasks
+    mutex WaitLock;
+    condition_variable Changed;
+    atomic<uint> NumWaiting;
+    
+    mutex SolutionLock;
+    uint NumSolutions, MaxSolutions;
+    vector<BV> FirstSolution;
+    
+    ParallelSearch(uint NumWorkers, uint MaxSolutions_):
+        Queues(NumWorkers), PendingTasks(0), NumIdle(0), Done(false), NumWaiting(0),
+        NumSolutions(0), MaxSolutions(MaxSolutions_) {}
+    
+    void AddTask(uint iwkr, vector<BV> &Task);
+    bool GetTask(uint iwkr, vector<BV> &Task);
+    // Marks a task finished, waking the sleeping workers if it was the last one
+    void FinishTask();
+    
+    // Sleeps until there is a task to take or the search is over
+    void WaitForTask();
+    // Wakes the sleeping workers, if any
+    void Wake();
+    
+    // Does this worker have no tasks queued for the idle ones to steal?
+    bool WantsTasks(uint iwkr) {return NumIdle > 0 && Queues[iwkr].NumTasks == 0;}
+    
+    // Returns whether the search is done
+    bool AddSolution(vector<BV> &Vals);
+};
+
+
+// Waits a little for another worker; returns false when it is time to sleep instead
+static inline bool Pause(uint &NumTries)
+{
+    if (++NumTries < 64) return true;
+    if (NumTries >= 128) return false;
+    this_thread::yield();
+    return true;
 }
 
 
-uint VectorSum(byte *Vec, uint IndMin, uint IndMax)
+// The solver proper: the candidate values are bit vectors of type BV
+// If FixRows and FixCols are nonzero, then they are the block dimensions,
+// fixed at compile time, so the loops over the board have constant trip counts.
+// Otherwise, the block dimensions are set at run time.
+
+template<class BV, uint FixRows, uint FixCols> class SolverCore: public Solver
 {
-    uint Sum = 0;
-    for (uint i=IndMin; i<=IndMax; i++)
-        Sum += Vec[i];
+    uint BlockRows, BlockCols, SideLength, BoardSize;
+    
+    vector<BV> AvailVals;
+    
+    // An index of the candidates for the fish, wings, and coloring, kept up to date with them:
+    // the bivalue cells, one bit per cell, 64 to a word,
+    // and the number of places for each value in each group, SideLength of them per group,
+    // where 2 makes those places a conjugate pair
+    vector<uint64_t> BivalueCells;
+    vector<byte> PlaceCounts;
+    
+    shared_ptr<const BoardTables> Tables;
+    
+    uint MaxVisSetSize, MaxHidSetSize;
+    
+    // For rerunning the techniques only on groups that have changed:
+    // a count of all the changes to the candidates,
+    // the count at each group's latest change,
+    // and the count when each technique last found nothing to do in each group
+    size_t ChangeCount;
+    vector<size_t> GroupChanges;
+    vector<size_t> TechChecks;
+    
+    // For undoing changes in a search: the cells changed and their previous candidates
+    bool UseTrail;
+    vector< pair<uint,BV> > Trail;
+    
+    // For counting solutions in a search: how many have been found,
+    // how many to look for, and the first one found
+    uint NumSolutions, MaxSolutions;
+    vector<BV> FirstSolution;
+    
+    // For a search split across threads: the shared state and this copy's worker index.
+    // It is NULL otherwise
+    ParallelSearch<BV> *Shared;
+    uint WorkerIndex;
+    
+#if SOLVER_STATS
+    // Candidates removed so far, and the statistics, indexed by technique
+    unsigned long long NumEliminated;
+    vector<TechniqueStats> Stats;
+#endif
+    
+    // Removes candidate values from a cell that has some of them
+    bool RemoveSome(uint icell, BV Vals);
+    
+    // Records a change in a cell's row, column, and block
+    void RecordChange(uint icell);
+    
+    // Updates the index for a cell's change from its previous candidates, or makes it over for the whole board
+    void UpdateIndex(uint icell, BV PrevAvail);
+    void MakeIndex();
+    
+    // Undoes the changes in the trail back to the given size
+    void UndoTo(size_t TrailSize);
+    
+    // One node of the search: deduce, then branch on a cell
+    // Returns whether the search is done: whether it has found all the solutions it is looking for
+    bool SearchNode(SolverParameters &NodeParams);
     
-    return Sum;
+    // Splits the search across NumThreads threads, each with its own copy of this solver
+    void SearchParallel(SolverParameters &NodeParams, uint NumThreads);
+    
+    // Runs a worker's tasks until the search is over
+    void SearchWorker(SolverParameters &NodeParams);
+    
+public:
+    typedef BV BitVec;
+    static const uint FixSize = FixRows * FixCols;
+    
+    SolverCore(uint BlockRows_, uint BlockCols_);
+    
+    uint GetBlockRows() {return (FixRows > 0) ? FixRows : BlockRows;}
+    uint GetBlockCols() {return (FixCols > 0) ? FixCols : BlockCols;}
+    uint GetSideLength() {return (FixSize > 0) ? FixSize : SideLength;}
+    uint GetBoardSize() {return (FixSize > 0) ? FixSize*FixSize : BoardSize;}
+    
+    // The biggest visible and hidden sets worth looking for:
+    // one that fills a group tells nothing
+    uint GetMaxSetSize() {return max(GetSideLength()-1,1U);}
+    
+    // The biggest fish worth looking for: one in more than half the lines
+    // makes the same eliminations as a smaller one in the other direction
+    uint GetMaxFishSize() {return GetSideLength()/2;}
+    
+    // The set sizes that the techniques are currently looking for,
+    // so that each kind of set can skip what the other kind has covered
+    void SetMaxSetSizes(uint MaxVis, uint MaxHid) {MaxVisSetSize = MaxVis; MaxHidSetSize = MaxHid;}
+    uint GetMaxVisSetSize() {return MaxVisSetSize;}
+    uint GetMaxHidSetSize() {return MaxHidSetSize;}
+    
+    // The candidate values of a cell
+    BV &Avail(uint icell) {return AvailVals[icell];}
+    BV &Avail(uint irow, uint icol) {return AvailVals[GetSideLength()*irow+icol];}
+    
+    // Removes candidate values from a cell and records the change
+    // Returns whether there was a change.
+    // Most calls have nothing to remove, so that case is inline
+    bool Remove(uint icell, BV Vals) {return BV(AvailVals[icell] & Vals) != BV(0) && RemoveSome(icell,Vals);}
+    bool Remove(uint irow, uint icol, BV Vals) {return Remove(GetSideLength()*irow+icol,Vals);}
+    
+    // Groups: rows, then columns, then blocks
+    uint GetNumGroups() {return 3*GetSideLength();}
+    uint RowGroup(uint irow) {return irow;}
+    uint ColGroup(uint icol) {return GetSideLength() + icol;}
+    uint BlockGroup(uint iblk) {return 2*GetSideLength() + iblk;}
+    
+    // The change count at a group's latest change, and at the board's latest change
+    size_t GroupChange(uint igrp) {return GroupChanges[igrp];}
+    size_t BoardChange() {return ChangeCount;}
+    
+    // Does a technique need to be run on a group?
+    // Not if the group has not changed since the technique last found nothing to do there.
+    // The latest change may include other groups that the technique looks at
+    bool NeedsCheck(uint itech, uint igrp, size_t LatestChange)
+    {return LatestChange > TechChecks[GetNumGroups()*itech+igrp];}
+    bool NeedsCheck(uint itech, uint igrp) {return NeedsCheck(itech,igrp,GroupChanges[igrp]);}
+    
+    // Record that a technique has found nothing to do in a group
+    void SetChecked(uint itech, uint igrp) {TechChecks[GetNumGroups()*itech+igrp] = ChangeCount;}
+    
+    // The indices of a group's cells, of a cell's groups, and of a cell's peers
+    const uint *GroupCells(uint igrp) {return &Tables->GroupCells[GetSideLength()*igrp];}
+    const uint *CellGroups(uint icell) {return &Tables->CellGroups[3*icell];}
+    uint GetNumPeers() {return Tables->NumPeers;}
+    const uint *Peers(uint icell) {return Tables->Peers.data() + GetNumPeers()*icell;}
+    
+    // Is a cell a bivalue cell, and how many places does a value have in a group?
+    bool IsBivalue(uint icell) {return ((BivalueCells[icell/64] >> (icell%64)) & 1) != 0;}
+    uint NumPlaces(uint igrp, uint ival) {return PlaceCounts[GetSideLength()*igrp+ival];}
+    
+    // Do two different cells share a group?
+    bool Sees(uint icell, uint jcell)
+    {
+        const uint *Groups = CellGroups(icell), *OtherGroups = CellGroups(jcell);
+        return icell != jcell &&
+            (Groups[0] == OtherGroups[0] || Groups[1] == OtherGroups[1] || Groups[2] == OtherGroups[2]);
+    }
+    
+    // The strip-block intersections
+    const IntersectionTable &RowIntersections() {return Tables->RowItsc;}
+    const IntersectionTable &ColIntersections() {return Tables->ColItsc;}
+    
+    // Is the board contradictory, still open, or solved?
+    int CheckBoard();
+    
+#if SOLVER_STATS
+    // For the statistics: the candidates removed so far, and a record of a technique's pass over the board
+    unsigned long long GetNumEliminated() {return NumEliminated;}
+    void RecordPass(uint itech, unsigned long long Eliminated, double Time);
+#endif
+    
+    // The cell with the fewest candidates, not counting cells with only one
+    uint ChooseBranchCell();
+    
+    void SetFromValues(byte *Vals);
+    void Solve(SolverParameters &Params);
+    void Grade(SolverParameters &Params, SolverGrade &Grade);
+    bool Search(SolverParameters &Params);
+    uint CountSolutions(SolverParameters &Params, uint MaxCount);
+    void GetValues(byte *Vals);
+    bool Avail(uint irow, uint icol, uint ival) {return BitTest(Avail(irow,icol),ival-1);}
+    void GetCandidates(uint64_t *Masks);
+    void SetCandidates(const uint64_t *Masks);
+    void GetStats(vector<TechniqueStats> &StatsOut);
+    void ClearStats();
+};
+
+
+// Records a technique's pass over the board when it goes out of scope.
+// Without the statistics, it is empty and does nothing
+
+#if SOLVER_STATS
+template<class Core> class TechniquePass
+{
+    Core &Board;
+    uint itech;
+    unsigned long long StartEliminated;
+    chrono::steady_clock::time_point StartTime;
+    
+public:
+    TechniquePass(Core &Board_, uint itech_):
+        Board(Board_), itech(itech_), StartEliminated(Board_.GetNumEliminated()),
+        StartTime(chrono::steady_clock::now()) {}
+    ~TechniquePass()
+    {
+        chrono::duration<double> Elapsed = chrono::steady_clock::now() - StartTime;
+        Board.RecordPass(itech,Board.GetNumEliminated()-StartEliminated,Elapsed.count());
+    }
+};
+#else
+template<class Core> class TechniquePass
+{
+public:
+    TechniquePass(Core &, uint) {}
+};
+#endif
+
+
+// These functions are templated on the solver core
+// The group-level ones get the indices of the group's cells
+
+template<class Core> static void ApplyTechniques(Core &Board, SolverParameters &Params);
+template<class Core> static void GradeTechniques(Core &Board, SolverParameters &Params, SolverGrade &Grade);
+
+template<class Core, bool (*Func)(Core &, const uint *, uint)>
+static bool DistribRowColBlk(Core &Board, uint itech, uint SetSize, bool DoneIfOnce = true);
+
+template<class Core> static bool VisOne(Core &Board, const uint *Cells, uint SetSize);
+template<class Core> static bool VisSets(Core &Board, const uint *Cells, uint SetSize);
+
+template<class Core> static bool HidOne(Core &Board, const uint *Cells, uint SetSize);
+template<class Core> static bool HidSets(Core &Board, const uint *Cells, uint SetSize);
+
+template<class Core> static bool ItscBlkStrip(Core &Board, uint itech, const IntersectionTable &Table);
+template<class Core> static bool Itsc(Core &Board);
+
+template<class Core> static bool FishLines(Core &Board, uint FishSize, bool IsCols);
+template<class Core> static bool Fish(Core &Board, uint FishSize);
+
+template<class Core> static bool XYWing(Core &Board);
+template<class Core> static bool XYZWing(Core &Board);
+template<class Core> static bool Coloring(Core &Board);
+
+
+Solver *MakeSolver(uint BlockRows, uint BlockCols)
+{
+    // The common block sizes get their own compile-time versions
+    if (BlockRows == 2 && BlockCols == 2) return new SolverCore<BitVec16,2,2>(BlockRows,BlockCols);
+    if (BlockRows == 2 && BlockCols == 3) return new SolverCore<BitVec16,2,3>(BlockRows,BlockCols);
+    if (BlockRows == 3 && BlockCols == 2) return new SolverCore<BitVec16,3,2>(BlockRows,BlockCols);
+    if (BlockRows == 3 && BlockCols == 3) return new SolverCore<BitVec16,3,3>(BlockRows,BlockCols);
+    if (BlockRows == 3 && BlockCols == 4) return new SolverCore<BitVec16,3,4>(BlockRows,BlockCols);
+    if (BlockRows == 4 && BlockCols == 3) return new SolverCore<BitVec16,4,3>(BlockRows,BlockCols);
+    if (BlockRows == 4 && BlockCols == 4) return new SolverCore<BitVec16,4,4>(BlockRows,BlockCols);
+    if (BlockRows == 5 && BlockCols == 5) return new SolverCore<BitVec64,5,5>(BlockRows,BlockCols);
+    
+    // All the others
+    uint SideLength = BlockRows * BlockCols;
+    
+    if (SideLength <= 16)
+        return new SolverCore<BitVec16,0,0>(BlockRows,BlockCols);
+    else if (SideLength <= 64)
+        return new SolverCore<BitVec64,0,0>(BlockRows,BlockCols);
+    else
+        return new SolverCore<BitVec128,0,0>(BlockRows,BlockCols);
 }
 
-bool DistribRowColBlk(BoardManager &Board, DistRCBFunc Func, bool DoneIfOnce)
+
+template<class BV, uint FixRows, uint FixCols>
+SolverCore<BV,FixRows,FixCols>::SolverCore(uint BlockRows_, uint BlockCols_)
 {
-    // Set up
-    uint BlockRows = Board.GetBlockRows();
-    uint BlockCols = Board.GetBlockCols();
-    uint SideLength = Board.GetSideLength();
-    vector<byte *> AvailSet(SideLength);
-    byte **AvailPtr = &AvailSet[0];
+    BlockRows = BlockRows_;
+    BlockCols = BlockCols_;
+    SideLength = BlockRows * BlockCols;
+    BoardSize = SideLength * SideLength;
     
-    bool rctot = false;
+    Tables = make_shared<const BoardTables>(BlockRows,BlockCols);
+    
+    // Initialize the availability as all possible
+    AvailVals.resize(BoardSize);
+    fill(AvailVals.begin(),AvailVals.end(),BitRange<BV>(SideLength));
+    MakeIndex();
+    
+    // Every group needs checking by every technique
+    ChangeCount = 1;
+    GroupChanges.resize(3*SideLength);
+    fill(GroupChanges.begin(),GroupChanges.end(),ChangeCount);
+    uint NumTechs = TechFishBase(GetMaxSetSize()) + 2*(max(GetMaxFishSize(),1U)-1);
+    TechChecks.resize(NumTechs*3*SideLength);
+    fill(TechChecks.begin(),TechChecks.end(),0);
+    
+    MaxVisSetSize = MaxHidSetSize = 0;
+    
+    UseTrail = false;
+    Shared = NULL;
+    WorkerIndex = 0;
+    
+#if SOLVER_STATS
+    NumEliminated = 0;
+    Stats.resize(NumTechs);
+    for (uint itech=0; itech<NumTechs; itech++)
+        Stats[itech].Name = TechName(itech,GetMaxSetSize());
+#endif
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::SetFromValues(byte *Vals)
+{
+    uint SideLength = GetSideLength();
+    uint BoardSize = GetBoardSize();
+    BV AllVals = BitRange<BV>(SideLength);
+    for (uint ic=0; ic<BoardSize; ic++)
+    {
+        byte CellVal = Vals[ic];
+        AvailVals[ic] = (CellVal > 0) ? BitSingle<BV>(CellVal-1) : AllVals;
+    }
+    MakeIndex();
+    
+    // Every group needs checking again
+    ChangeCount++;
+    fill(GroupChanges.begin(),GroupChanges.end(),ChangeCount);
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::Solve(SolverParameters &Params)
+{
+    // Iterate over the solution code
+    // Check for changes at each iteration with the change count
+    size_t PrevChangeCount;
+    do {
+        PrevChangeCount = ChangeCount;
+        ApplyTechniques(*this, Params);
+    } while(ChangeCount != PrevChangeCount);
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::Grade(SolverParameters &Params, SolverGrade &Grade)
+{
+    Grade = SolverGrade();
+    size_t PrevChangeCount;
+    do {
+        PrevChangeCount = ChangeCount;
+        GradeTechniques(*this, Params, Grade);
+    } while(ChangeCount != PrevChangeCount);
+    
+    uint BoardSize = GetBoardSize();
+    Grade.IsSolved = true;
+    for (uint ic=0; ic<BoardSize; ic++)
+        if (BitCount(AvailVals[ic]) != 1) Grade.IsSolved = false;
+}
+
+template<class BV, uint FixRows, uint FixCols>
+bool SolverCore<BV,FixRows,FixCols>::RemoveSome(uint icell, BV Vals)
+{
+    BV PrevAvail = AvailVals[icell];
+    if (!BitSubFmCheck(AvailVals[icell],Vals)) return false;
+    
+#if SOLVER_STATS
+    NumEliminated += BitCount(PrevAvail) - BitCount(AvailVals[icell]);
+#endif
+    if (UseTrail) Trail.push_back(make_pair(icell,PrevAvail));
+    UpdateIndex(icell,PrevAvail);
+    RecordChange(icell);
+    
+    return true;
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::RecordChange(uint icell)
+{
+    ChangeCount++;
+    const uint *Groups = CellGroups(icell);
+    GroupChanges[Groups[0]] = ChangeCount;
+    GroupChanges[Groups[1]] = ChangeCount;
+    GroupChanges[Groups[2]] = ChangeCount;
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::UndoTo(size_t TrailSize)
+{
+    while (Trail.size() > TrailSize)
+    {
+        uint icell = Trail.back().first;
+        BV PrevAvail = AvailVals[icell];
+        AvailVals[icell] = Trail.back().second;
+        Trail.pop_back();
+        
+        // The techniques have to look at this cell's groups again
+        UpdateIndex(icell,PrevAvail);
+        RecordChange(icell);
+    }
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::UpdateIndex(uint icell, BV PrevAvail)
+{
+    BV CellAvail = AvailVals[icell];
+    uint64_t CellBit = uint64_t(1) << (icell%64);
+    if (BitCount(CellAvail) == 2)
+        BivalueCells[icell/64] |= CellBit;
+    else
+        BivalueCells[icell/64] &= ~CellBit;
+    
+    // Each value in only one of them has been removed or put back
+    uint SideLength = GetSideLength();
+    const uint *Groups = CellGroups(icell);
+    BV Changed = CellAvail ^ PrevAvail;
+    while (Changed != 0)
+    {
+        uint ival = BitFirst(Changed);
+        int Delta = BitTest(CellAvail,ival) ? 1 : -1;
+        for (uint ig=0; ig<3; ig++)
+            PlaceCounts[SideLength*Groups[ig]+ival] += Delta;
+        Changed = BitClearFirst(Changed);
+    }
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::MakeIndex()
+{
+    uint SideLength = GetSideLength();
+    uint BoardSize = GetBoardSize();
+    BivalueCells.assign((BoardSize+63)/64,0);
+    PlaceCounts.assign(GetNumGroups()*SideLength,0);
+    for (uint ic=0; ic<BoardSize; ic++)
+    {
+        BV CellAvail = AvailVals[ic];
+        if (BitCount(CellAvail) == 2) BivalueCells[ic/64] |= uint64_t(1) << (ic%64);
+        const uint *Groups = CellGroups(ic);
+        while (CellAvail != 0)
+        {
+            uint ival = BitFirst(CellAvail);
+            for (uint ig=0; ig<3; ig++)
+                PlaceCounts[SideLength*Groups[ig]+ival]++;
+            CellAvail = BitClearFirst(CellAvail);
+        }
+    }
+}
+
+#if SOLVER_STATS
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::RecordPass(uint itech, unsigned long long Eliminated, double Time)
+{
+    TechniqueStats &TS = Stats[itech];
+    TS.Invocations++;
+    if (Eliminated > 0) TS.Productive++;
+    TS.Eliminated += Eliminated;
+    TS.Time += Time;
+}
+#endif
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::GetStats(vector<TechniqueStats> &StatsOut)
+{
+    StatsOut.clear();
+#if SOLVER_STATS
+    // The sets and the fish, then the intersections, then the wings and coloring
+    for (uint itech=TechSetBase; itech<Stats.size(); itech++)
+        StatsOut.push_back(Stats[itech]);
+    for (uint itech=0; itech<TechSetBase; itech++)
+        StatsOut.push_back(Stats[itech]);
+#endif
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::ClearStats()
+{
+#if SOLVER_STATS
+    for (uint itech=0; itech<Stats.size(); itech++)
+    {
+        TechniqueStats &TS = Stats[itech];
+        TS.Invocations = TS.Productive = TS.Eliminated = 0;
+        TS.Time = 0;
+    }
+#endif
+}
+
+BoardTables::BoardTables(uint BlockRows, uint BlockCols)
+{
+    SideLength = BlockRows * BlockCols;
+    uint BoardSize = SideLength * SideLength;
+    uint NumGroups = 3*SideLength;
     
-    // Do rows
+    // Groups: rows, then columns, then blocks, as in the solver
+    GroupCells.resize(NumGroups*SideLength);
+    CellGroups.resize(3*BoardSize);
     for (uint irow=0; irow<SideLength; irow++)
     {
         for (uint icol=0; icol<SideLength; icol++)
-            AvailPtr[icol] = &Board.Avail(irow,icol,0);
+        {
+            uint icell = SideLength*irow + icol;
+            uint iblk = (irow/BlockRows)*BlockRows + icol/BlockCols;
+            uint ixblk = (irow%BlockRows)*BlockCols + icol%BlockCols;
+            
+            GroupCells[SideLength*irow + icol] = icell;
+            GroupCells[SideLength*(SideLength + icol) + irow] = icell;
+            GroupCells[SideLength*(2*SideLength + iblk) + ixblk] = icell;
+            
+            CellGroups[3*icell] = irow;
+            CellGroups[3*icell+1] = SideLength + icol;
+            CellGroups[3*icell+2] = 2*SideLength + iblk;
+        }
+    }
+    
+    // Peers: the rest of the row and column, and the part of the block outside of them
+    NumPeers = 2*(SideLength - 1) + (BlockRows - 1)*(BlockCols - 1);
+    // With data() since 1x1 boards have no peers, leaving nothing to index
+    Peers.resize(NumPeers*BoardSize);
+    for (uint icell=0; icell<BoardSize; icell++)
+    {
+        const uint *Groups = &CellGroups[3*icell];
+        uint *CellPeers = Peers.data() + NumPeers*icell;
+        uint NumFound = 0;
+        for (uint ic=0; ic<BoardSize; ic++)
+        {
+            if (ic == icell) continue;
+            const uint *OtherGroups = &CellGroups[3*ic];
+            if (OtherGroups[0] == Groups[0] || OtherGroups[1] == Groups[1] || OtherGroups[2] == Groups[2])
+                CellPeers[NumFound++] = ic;
+        }
+    }
+    
+    // Intersections of blocks with their rows, then with their columns
+    for (uint kind=0; kind<2; kind++)
+    {
+        IntersectionTable &Table = (kind == 0) ? RowItsc : ColItsc;
+        Table.SegLength = (kind == 0) ? BlockCols : BlockRows;
+        Table.NumPerBlock = (kind == 0) ? BlockRows : BlockCols;
+        Table.Stride = 2*SideLength - Table.SegLength;
         
-        if (Func(AvailPtr,SideLength))
+        uint NumItsc = SideLength*Table.NumPerBlock;
+        Table.StripGroups.resize(NumItsc);
+        Table.BlockGroups.resize(NumItsc);
+        Table.Cells.resize(NumItsc*Table.Stride);
+        
+        uint iitsc = 0;
+        for (uint iblk=0; iblk<SideLength; iblk++)
         {
-            if (DoneIfOnce) return true;
-            rctot = true;
+            uint iblkgrp = 2*SideLength + iblk;
+            const uint *BlockCells = &GroupCells[SideLength*iblkgrp];
+            for (uint istr=0; istr<Table.NumPerBlock; istr++)
+            {
+                // The strip: a row or a column through this block
+                uint istrgrp = CellGroups[3*BlockCells[(kind == 0) ? istr*BlockCols : istr] + kind];
+                const uint *StripCells = &GroupCells[SideLength*istrgrp];
+                
+                Table.StripGroups[iitsc] = istrgrp;
+                Table.BlockGroups[iitsc] = iblkgrp;
+                
+                uint *SegCells = &Table.Cells[Table.Stride*iitsc];
+                uint *StripRest = SegCells + Table.SegLength;
+                uint *BlockRest = StripRest + (SideLength - Table.SegLength);
+                for (uint ix=0; ix<SideLength; ix++)
+                {
+                    uint ic = StripCells[ix];
+                    if (CellGroups[3*ic+2] == iblkgrp)
+                        *(SegCells++) = ic;
+                    else
+                        *(StripRest++) = ic;
+                }
+                // Strip by strip, the same way as the segments
+                for (uint ix=0; ix<SideLength; ix++)
+                {
+                    uint ic = (kind == 0) ? BlockCells[ix] :
+                        BlockCells[(ix%BlockRows)*BlockCols + ix/BlockRows];
+                    if (CellGroups[3*ic+kind] != istrgrp)
+                        *(BlockRest++) = ic;
+                }
+                iitsc++;
+            }
         }
     }
+}
+
+template<class BV, uint FixRows, uint FixCols>
+int SolverCore<BV,FixRows,FixCols>::CheckBoard()
+{
+    uint SideLength = GetSideLength();
+    uint BoardSize = GetBoardSize();
+    
+    // Every cell must have some candidate
+    bool Solved = true;
+    for (uint ic=0; ic<BoardSize; ic++)
+    {
+        uint NumAvail = BitCount(AvailVals[ic]);
+        if (NumAvail == 0) return BoardBad;
+        if (NumAvail > 1) Solved = false;
+    }
+    
+    // Every value must be a candidate somewhere in every group
+    // For a solved board, this means that the values in each group are all different
+    BV AllVals = BitRange<BV>(SideLength);
+    uint NumGroups = GetNumGroups();
+    for (uint igrp=0; igrp<NumGroups; igrp++)
+    {
+        const uint *Cells = GroupCells(igrp);
+        BV SetUnion = 0;
+        for (uint ix=0; ix<SideLength; ix++)
+            SetUnion |= AvailVals[Cells[ix]];
+        if (SetUnion != AllVals) return BoardBad;
+    }
+    
+    return Solved ? BoardSolved : BoardOpen;
+}
+
+template<class BV, uint FixRows, uint FixCols>
+uint SolverCore<BV,FixRows,FixCols>::ChooseBranchCell()
+{
+    uint BoardSize = GetBoardSize();
+    uint BestCell = 0;
+    uint BestNum = 8*sizeof(BV) + 1;
+    for (uint ic=0; ic<BoardSize; ic++)
+    {
+        uint NumAvail = BitCount(AvailVals[ic]);
+        if (NumAvail <= 1 || NumAvail >= BestNum) continue;
+        BestCell = ic;
+        BestNum = NumAvail;
+        // Can't do better than this
+        if (BestNum == 2) break;
+    }
+    return BestCell;
+}
+
+template<class BV, uint FixRows, uint FixCols>
+bool SolverCore<BV,FixRows,FixCols>::Search(SolverParameters &Params)
+{
+    return (CountSolutions(Params,1) > 0);
+}
+
+template<class BV, uint FixRows, uint FixCols>
+uint SolverCore<BV,FixRows,FixCols>::CountSolutions(SolverParameters &Params, uint MaxCount)
+{
+    // The deduction at each node: the visible and hidden sets up to the search set size,
+    // and at least singles, so that each trial value gets removed from the rest of its groups
+    SolverParameters NodeParams = Params;
+    uint SetSize = max(Params.SearchSetSize,1U);
+    NodeParams.MaxVisibleSetSize = SetSize;
+    NodeParams.MaxHiddenSetSize = SetSize;
+    
+    NumSolutions = 0;
+    MaxSolutions = max(MaxCount,1U);
+    
+    UseTrail = true;
+    Trail.clear();
+    
+    uint NumThreads = Params.SearchThreads;
+    if (NumThreads == 0) NumThreads = max(thread::hardware_concurrency(),1U);
+    
+    if (NumThreads > 1)
+        SearchParallel(NodeParams,NumThreads);
+    else
+        SearchNode(NodeParams);
+    
+    if (NumSolutions > 0)
+    {
+        // Go to the first solution found
+        uint BoardSize = GetBoardSize();
+        for (uint ic=0; ic<BoardSize; ic++)
+        {
+            if (AvailVals[ic] == FirstSolution[ic]) continue;
+            BV PrevAvail = AvailVals[ic];
+            AvailVals[ic] = FirstSolution[ic];
+            UpdateIndex(ic,PrevAvail);
+            RecordChange(ic);
+        }
+    }
+    else
+    {
+        // No solution, so go back to where the search started
+        UndoTo(0);
+    }
+    
+    UseTrail = false;
+    Trail.clear();
+    
+    return NumSolutions;
+}
+
+template<class BV, uint FixRows, uint FixCols>
+bool SolverCore<BV,FixRows,FixCols>::SearchNode(SolverParameters &NodeParams)
+{
+    // Some other worker may have finished the search
+    if (Shared != NULL && Shared->Done) return true;
+    
+    ApplyTechniques(*this, NodeParams);
+    
+    int State = CheckBoard();
+    if (State == BoardBad) return false;
+    if (State == BoardSolved)
+    {
+        if (Shared != NULL) return Shared->AddSolution(AvailVals);
+        if (NumSolutions == 0) FirstSolution = AvailVals;
+        NumSolutions++;
+        return (NumSolutions >= MaxSolutions);
+    }
+    
+    // Try each of the branch cell's candidates in turn,
+    // and undo it if it leads to a contradiction
+    uint icell = ChooseBranchCell();
+    BV Vals = AvailVals[icell];
+    size_t TrailSize = Trail.size();
+    
+    // If some worker is idle, hand it all the candidates but the first
+    if (Shared != NULL && Shared->WantsTasks(WorkerIndex))
+    {
+        BV Rest = BitClearFirst(Vals);
+        while (Rest != 0)
+        {
+            vector<BV> Task = AvailVals;
+            Task[icell] = BitSingle<BV>(BitFirst(Rest));
+            Rest = BitClearFirst(Rest);
+            Shared->AddTask(WorkerIndex,Task);
+        }
+        Vals = BitSingle<BV>(BitFirst(Vals));
+    }
+    
+    while (Vals != 0)
+    {
+        BV Others = ~BitSingle<BV>(BitFirst(Vals));
+        Vals = BitClearFirst(Vals);
+        
+        Remove(icell,Others);
+        if (SearchNode(NodeParams)) return true;
+        UndoTo(TrailSize);
+    }
+    
+    return false;
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::SearchParallel(SolverParameters &NodeParams, uint NumThreads)
+{
+    ParallelSearch<BV> SharedSearch(NumThreads,MaxSolutions);
+    
+    // The whole search is the first worker's first task
+    vector<BV> Root = AvailVals;
+    SharedSearch.AddTask(0,Root);
+    
+    // The workers' copies; this solver stays where the search started
+    vector<SolverCore> Workers(NumThreads,*this);
+    vector<thread> Threads;
+    for (uint iwkr=0; iwkr<NumThreads; iwkr++)
+    {
+        Workers[iwkr].Shared = &SharedSearch;
+        Workers[iwkr].WorkerIndex = iwkr;
+#if SOLVER_STATS
+        Workers[iwkr].ClearStats();
+#endif
+        Threads.push_back(thread(&SolverCore::SearchWorker,&Workers[iwkr],ref(NodeParams)));
+    }
+    for (uint iwkr=0; iwkr<NumThreads; iwkr++)
+        Threads[iwkr].join();
+    
+#if SOLVER_STATS
+    // Add up the workers' statistics
+    for (uint iwkr=0; iwkr<NumThreads; iwkr++)
+    {
+        for (uint itech=0; itech<Stats.size(); itech++)
+        {
+            TechniqueStats &TS = Stats[itech];
+            TechniqueStats &WTS = Workers[iwkr].Stats[itech];
+            TS.Invocations += WTS.Invocations;
+            TS.Productive += WTS.Productive;
+            TS.Eliminated += WTS.Eliminated;
+            TS.Time += WTS.Time;
+        }
+    }
+#endif
+    
+    NumSolutions = SharedSearch.NumSolutions;
+    if (NumSolutions > 0) FirstSolution.swap(SharedSearch.FirstSolution);
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::SearchWorker(SolverParameters &NodeParams)
+{
+    vector<BV> Task;
+    bool Idle = false;
+    uint NumTries = 0;
+    while (!Shared->Done)
+    {
+        if (!Shared->GetTask(WorkerIndex,Task))
+        {
+            if (Shared->PendingTasks == 0) break;
+            if (!Idle) {Shared->NumIdle++; Idle = true;}
+            if (!Pause(NumTries))
+            {
+                Shared->WaitForTask();
+                NumTries = 0;
+            }
+            continue;
+        }
+        if (Idle) {Shared->NumIdle--; Idle = false;}
+        NumTries = 0;
+        
+        // Start from the task's candidates, with every group needing checking again
+        AvailVals.swap(Task);
+        MakeIndex();
+        ChangeCount++;
+        fill(GroupChanges.begin(),GroupChanges.end(),ChangeCount);
+        Trail.clear();
+        
+        SearchNode(NodeParams);
+        Shared->FinishTask();
+    }
+    if (Idle) Shared->NumIdle--;
+}
+
+template<class BV> void ParallelSearch<BV>::AddTask(uint iwkr, vector<BV> &Task)
+{
+    // Count it before any worker can take it, so the count can't reach 0 too soon
+    PendingTasks++;
+    {
+        SearchTaskQueue<BV> &Queue = Queues[iwkr];
+        lock_guard<mutex> Guard(Queue.Lock);
+        Queue.Tasks.push_back(vector<BV>());
+        Queue.Tasks.back().swap(Task);
+        Queue.NumTasks = Queue.Tasks.size();
+    }
+    Wake();
+}
+
+template<class BV> bool ParallelSearch<BV>::GetTask(uint iwkr, vector<BV> &Task)
+{
+    // From the back of this worker's own queue
+    {
+        SearchTaskQueue<BV> &Queue = Queues[iwkr];
+        lock_guard<mutex> Guard(Queue.Lock);
+        if (!Queue.Tasks.empty())
+        {
+            Task.swap(Queue.Tasks.back());
+            Queue.Tasks.pop_back();
+            Queue.NumTasks = Queue.Tasks.size();
+            return true;
+        }
+    }
+    
+    // Steal from the front of some other worker's queue
+    uint NumWorkers = (uint)Queues.size();
+    for (uint ix=1; ix<NumWorkers; ix++)
+    {
+        SearchTaskQueue<BV> &Queue = Queues[(iwkr+ix) % NumWorkers];
+        if (Queue.NumTasks == 0) continue;
+        lock_guard<mutex> Guard(Queue.Lock);
+        if (!Queue.Tasks.empty())
+        {
+            Task.swap(Queue.Tasks.front());
+            Queue.Tasks.pop_front();
+            Queue.NumTasks = Queue.Tasks.size();
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+template<class BV> void ParallelSearch<BV>::FinishTask()
+{
+    if (--PendingTasks == 0) Wake();
+}
+
+template<class BV> void ParallelSearch<BV>::WaitForTask()
+{
+    // Counted before checking for tasks, so that Wake() either sees the count
+    // or else this sees the new task or state
+    unique_lock<mutex> Lock(WaitLock);
+    NumWaiting++;
+    while (!Done && PendingTasks != 0)
+    {
+        bool HasTask = false;
+        for (size_t iq=0; iq<Queues.size(); iq++)
+            if (Queues[iq].NumTasks != 0) {HasTask = true; break;}
+        if (HasTask) break;
+        Changed.wait(Lock);
+    }
+    NumWaiting--;
+}
+
+template<class BV> void ParallelSearch<BV>::Wake()
+{
+    if (NumWaiting.load() == 0) return;
+    // Taking the lock keeps the wakeup from arriving between a worker's check and its wait
+    lock_guard<mutex> Lock(WaitLock);
+    Changed.notify_all();
+}
+
+template<class BV> bool ParallelSearch<BV>::AddSolution(vector<BV> &Vals)
+{
+    {
+        lock_guard<mutex> Guard(SolutionLock);
+        if (Done) return true;
+        if (NumSolutions == 0) FirstSolution = Vals;
+        NumSolutions++;
+        if (NumSolutions < MaxSolutions) return false;
+        Done = true;
+    }
+    Wake();
+    return true;
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::GetValues(byte *Vals)
+{
+    uint BoardSize = GetBoardSize();
+    for (uint ic=0; ic<BoardSize; ic++)
+    {
+        BV CellAvail = AvailVals[ic];
+        Vals[ic] = (BitCount(CellAvail) == 1) ? BitFirst(CellAvail) + 1 : 0;
+    }
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::GetCandidates(uint64_t *Masks)
+{
+    uint BoardSize = GetBoardSize();
+    uint NumWords = (GetSideLength()+63)/64;
+    for (uint ic=0; ic<BoardSize; ic++)
+        for (uint iw=0; iw<NumWords; iw++)
+            *(Masks++) = BitWord(AvailVals[ic],iw);
+}
+
+template<class BV, uint FixRows, uint FixCols>
+void SolverCore<BV,FixRows,FixCols>::SetCandidates(const uint64_t *Masks)
+{
+    uint BoardSize = GetBoardSize();
+    uint NumWords = (GetSideLength()+63)/64;
+    for (uint ic=0; ic<BoardSize; ic++)
+        AvailVals[ic] = BitFromWords<BV>(Masks + NumWords*ic);
+    MakeIndex();
+    
+    // Every group needs checking again
+    ChangeCount++;
+    fill(GroupChanges.begin(),GroupChanges.end(),ChangeCount);
+}
+
+
+template<class Core> void ApplyTechniques(Core &Board, SolverParameters &Params)
+{
+    uint MaxVisSize = min(Params.MaxVisibleSetSize,Board.GetMaxSetSize());
+    uint MaxHidSize = min(Params.MaxHiddenSetSize,Board.GetMaxSetSize());
+    uint MaxSize = max(MaxVisSize,MaxHidSize);
+    Board.SetMaxSetSizes(MaxVisSize,MaxHidSize);
+next:
+    if (MaxVisSize >= 1 && DistribRowColBlk<Core,VisOne>(Board,TechVisSet(1),1,false)) goto next;
+    if (MaxHidSize >= 1 && DistribRowColBlk<Core,HidOne>(Board,TechHidSet(1),1)) goto next;
+    
+    for (uint SetSize=2; SetSize<=MaxSize; SetSize++)
+    {
+        if (MaxVisSize >= SetSize && DistribRowColBlk<Core,VisSets>(Board,TechVisSet(SetSize),SetSize)) goto next;
+        if (MaxHidSize >= SetSize && DistribRowColBlk<Core,HidSets>(Board,TechHidSet(SetSize),SetSize)) goto next;
+    }
+    
+    if (Params.UseIntersections && Itsc(Board)) goto next;
+    
+    uint MaxFishSize = min(Params.MaxFishSize,Board.GetMaxFishSize());
+    for (uint FishSize=2; FishSize<=MaxFishSize; FishSize++)
+        if (Fish(Board,FishSize)) goto next;
+    
+    if (Params.UseXYWing && XYWing(Board)) goto next;
+    if (Params.UseXYZWing && XYZWing(Board)) goto next;
+    if (Params.UseColoring && Coloring(Board)) goto next;
+}
+
+// Like ApplyTechniques(), but with intersections before the sets of 2 and up,
+// since they are easier to spot, and recording each technique that removes candidates.
+// Each one runs only when all the ones before it have stalled,
+// so the sizes recorded are the smallest that get as far
+template<class Core> void GradeTechniques(Core &Board, SolverParameters &Params, SolverGrade &Grade)
+{
+    uint MaxVisSize = min(Params.MaxVisibleSetSize,Board.GetMaxSetSize());
+    uint MaxHidSize = min(Params.MaxHiddenSetSize,Board.GetMaxSetSize());
+    uint MaxSize = max(MaxVisSize,MaxHidSize);
+    Board.SetMaxSetSizes(MaxVisSize,MaxHidSize);
+next:
+    if (MaxVisSize >= 1 && DistribRowColBlk<Core,VisOne>(Board,TechVisSet(1),1,false))
+    {
+        Grade.VisibleSetSize = max(Grade.VisibleSetSize,1U);
+        goto next;
+    }
+    if (MaxHidSize >= 1 && DistribRowColBlk<Core,HidOne>(Board,TechHidSet(1),1))
+    {
+        Grade.HiddenSetSize = max(Grade.HiddenSetSize,1U);
+        goto next;
+    }
+    
+    if (Params.UseIntersections && Itsc(Board))
+    {
+        Grade.UsedIntersections = true;
+        goto next;
+    }
+    
+    for (uint SetSize=2; SetSize<=MaxSize; SetSize++)
+    {
+        if (MaxVisSize >= SetSize && DistribRowColBlk<Core,VisSets>(Board,TechVisSet(SetSize),SetSize))
+        {
+            Grade.VisibleSetSize = max(Grade.VisibleSetSize,SetSize);
+            goto next;
+        }
+        if (MaxHidSize >= SetSize && DistribRowColBlk<Core,HidSets>(Board,TechHidSet(SetSize),SetSize))
+        {
+            Grade.HiddenSetSize = max(Grade.HiddenSetSize,SetSize);
+            goto next;
+        }
+    }
+    
+    uint MaxFishSize = min(Params.MaxFishSize,Board.GetMaxFishSize());
+    for (uint FishSize=2; FishSize<=MaxFishSize; FishSize++)
+    {
+        if (Fish(Board,FishSize))
+        {
+            Grade.FishSize = max(Grade.FishSize,FishSize);
+            goto next;
+        }
+    }
+    
+    if (Params.UseXYWing && XYWing(Board))
+    {
+        Grade.UsedXYWing = true;
+        goto next;
+    }
+    if (Params.UseXYZWing && XYZWing(Board))
+    {
+        Grade.UsedXYZWing = true;
+        goto next;
+    }
+    if (Params.UseColoring && Coloring(Board))
+    {
+        Grade.UsedColoring = true;
+        goto next;
+    }
+}
+
+
+template<class Core, bool (*Func)(Core &, const uint *, uint)>
+bool DistribRowColBlk(Core &Board, uint itech, uint SetSize, bool DoneIfOnce)
+{
+    TechniquePass<Core> Pass(Board,itech);
+    bool rctot = false;
     
-    // Do columns
-    for (uint icol=0; icol<SideLength; icol++)
+    // Do rows, then columns, then blocks,
+    // but only the groups that have changed since this technique last checked them
+    uint NumGroups = Board.GetNumGroups();
+    for (uint igrp=0; igrp<NumGroups; igrp++)
     {
-        for (uint irow=0; irow<SideLength; irow++)
-            AvailPtr[irow] = &Board.Avail(irow,icol,0);
+        if (!Board.NeedsCheck(itech,igrp)) continue;
         
-        if (Func(AvailPtr,SideLength))
+        if (Func(Board,Board.GroupCells(igrp),SetSize))
         {
             if (DoneIfOnce) return true;
             rctot = true;
         }
-    }
-    
-    // Do blocks
-    for (uint ibrow=0; ibrow<BlockCols; ibrow++)
-    {
-        for (uint ibcol=0; ibcol<BlockRows; ibcol++)
-        {
-            uint ix = 0;
-            for (uint ixrow=0; ixrow<BlockRows; ixrow++)
-            {
-                for (uint ixcol=0; ixcol<BlockCols; ixcol++)
-                {
-                    AvailPtr[ix] =
-                        &Board.Avail(ibrow*BlockRows+ixrow, ibcol*BlockCols+ixcol, 0);
-                    ix++;
-                }
-            }
-            
-            if (Func(AvailPtr,SideLength))
-            {
-                if (DoneIfOnce) return true;
-                rctot = true;
-            }
-        }
+        else
+            Board.SetChecked(itech,igrp);
     }
     
     return rctot;
@@ -131,732 +1216,757 @@ bool DistribRowColBlk(BoardManager &Board, DistRCBFunc Func, bool DoneIfOnce)
 
 // Visible sets
 
-bool VisOne(byte **Avail, uint Size)
+template<class Core> bool VisOne(Core &Board, const uint *Cells, uint)
 {
+    typedef typename Core::BitVec BV;
+    uint Size = Board.GetSideLength();
+    
     bool rc = false;
     
     for (uint i=0; i<Size; i++)
     {
         // The total visible set
-        byte *AvailPtr = Avail[i];
+        BV CellAvail = Board.Avail(Cells[i]);
         // Does it have the right size?
-        if (VectorSum(AvailPtr,1,Size) != 1) continue;
+        if (BitCount(CellAvail) != 1) continue;
         
         // Remove the visible set from the others in the row/column/block
         for (uint ix=0; ix<Size; ix++)
         {
             if (ix == i) continue;
-            if (VecSubFmCheck(Avail[ix],1,Size,AvailPtr)) rc = true;
+            if (Board.Remove(Cells[ix],CellAvail)) rc = true;
         }
     }
     
     return rc;
 }
 
-bool VisTwo(byte **Avail, uint Size)
+// Hidden sets
+
+template<class Core> bool HidOne(Core &Board, const uint *Cells, uint)
 {
-    vector<byte> SetUnion(Size+1);
-    byte *SetUnionPtr = &SetUnion[0];
+    typedef typename Core::BitVec BV;
+    uint Size = Board.GetSideLength();
+    
+    BV SetUnion;
+    BV SetDiff;
     
-    // Skipping over singles to save time
-    for (uint i1=0; i1<Size; i1++)
+    for (uint i=0; i<Size; i++)
     {
-        byte *AvailPtr1 = Avail[i1];
-        if (VectorSum(AvailPtr1,1,Size) <= 1) continue;
+        BV CellAvail = Board.Avail(Cells[i]);
+        if (BitCount(CellAvail) == 0) continue;
         
-        for (uint i2=i1+1; i2<Size; i2++)
+        // Get what's outside the set
+        SetUnion = 0;
+        for (uint ix=0; ix<Size; ix++)
         {
-            byte *AvailPtr2 = Avail[i2];
-            if (VectorSum(AvailPtr2,1,Size) <= 1) continue;
-            
-            // The total visible set
-            VecCopy(SetUnionPtr,1,Size,AvailPtr1);
-            VecOrTo(SetUnionPtr,1,Size,AvailPtr2);
-            // Does it have the right size?
-            if (VectorSum(SetUnionPtr,1,Size) != 2) continue;
-            
-            // Remove the visible set from the others in the row/column/block
-            bool rc = false;
-            for (uint ix=0; ix<Size; ix++)
-            {
-                if (ix == i1) continue;
-                if (ix == i2) continue;
-                if (VecSubFmCheck(Avail[ix],1,Size,SetUnionPtr)) rc = true;
-            }
-            if (rc) return true;
+            if (ix == i) continue;
+            SetUnion |= Board.Avail(Cells[ix]);
         }
+        
+        // Get the set's contents
+        // Remove outside the set from inside it
+        SetDiff = CellAvail & ~SetUnion;
+        // The right size?
+        if (BitCount(SetDiff) != 1) continue;
+        
+        // Trim down the set
+        SetDiff = ~SetDiff;
+        if (Board.Remove(Cells[i],SetDiff)) return true;
     }
     
     return false;
 }
 
-bool VisThree(byte **Avail, uint Size)
+// Visible and hidden sets of any size, for sizes of 2 and up
+
+// Finds sets of SetSize items whose masks have a union with SetSize members,
+// and calls Found with the items' indices and the union for each one
+// until it returns true. Returns whether it did.
+// It builds up the union one item at a time, and drops a partial set
+// as soon as its union gets too big, since adding items can only make it bigger.
+template<class BV, class Handler>
+static bool FindSets(const BV *Masks, uint NumItems, uint SetSize, Handler &Found)
 {
-    vector<byte> SetUnion(Size+1);
-    byte *SetUnionPtr = &SetUnion[0];
+    if (SetSize > NumItems) return false;
+    
+    // The items chosen at each depth and the unions of those before them
+    uint Items[8*sizeof(BV)];
+    BV Unions[8*sizeof(BV)];
     
-    // Skipping over singles to save time
-    for (uint i1=0; i1<Size; i1++)
+    uint Depth = 0;
+    Items[0] = 0;
+    Unions[0] = 0;
+    while (true)
     {
-        byte *AvailPtr1 = Avail[i1];
-        if (VectorSum(AvailPtr1,1,Size) <= 1) continue;
+        // Enough items left to fill out the set?
+        if (Items[Depth] + (SetSize - Depth) > NumItems)
+        {
+            if (Depth == 0) break;
+            Depth--;
+            Items[Depth]++;
+            continue;
+        }
         
-        for (uint i2=i1+1; i2<Size; i2++)
+        BV SetUnion = Unions[Depth] | Masks[Items[Depth]];
+        uint UnionSize = BitCount(SetUnion);
+        if (UnionSize > SetSize)
         {
-            byte *AvailPtr2 = Avail[i2];
-            if (VectorSum(AvailPtr2,1,Size) <= 1) continue;
-            
-            for (uint i3=i2+1; i3<Size; i3++)
-            {
-                byte *AvailPtr3 = Avail[i3];
-                if (VectorSum(AvailPtr3,1,Size) <= 1) continue;
-                
-                // The total visible set
-                VecCopy(SetUnionPtr,1,Size,AvailPtr1);
-                VecOrTo(SetUnionPtr,1,Size,AvailPtr2);
-                VecOrTo(SetUnionPtr,1,Size,AvailPtr3);
-                // Does it have the right size?
-                if (VectorSum(SetUnionPtr,1,Size) != 3) continue;
-                
-                // Remove the visible set from the others in the row/column/block
-                bool rc = false;
-                for (uint ix=0; ix<Size; ix++)
-                {
-                    if (ix == i1) continue;
-                    if (ix == i2) continue;
-                    if (ix == i3) continue;
-                    if (VecSubFmCheck(Avail[ix],1,Size,SetUnionPtr)) rc = true;
-                }
-                if (rc) return true;
-            }
+            Items[Depth]++;
+            continue;
+        }
+        
+        if (Depth+1 == SetSize)
+        {
+            if (UnionSize == SetSize && Found(Items,SetUnion)) return true;
+            Items[Depth]++;
+            continue;
         }
+        
+        Unions[Depth+1] = SetUnion;
+        Items[Depth+1] = Items[Depth] + 1;
+        Depth++;
     }
     
     return false;
 }
 
-bool VisFour(byte **Avail, uint Size)
+// For visible sets: removes the set's values from the group's other cells,
+// and the ignored values from the other unsolved ones
+template<class Core> struct VisSetRemover
 {
-    vector<byte> SetUnion(Size+1);
-    byte *SetUnionPtr = &SetUnion[0];
+    typedef typename Core::BitVec BV;
+    
+    Core &Board;
+    const uint *Cells;
+    const uint *SetCells;
+    uint SetSize;
+    BV IgnoreVals;
     
-    // Skipping over singles to save time
-    for (uint i1=0; i1<Size; i1++)
+    VisSetRemover(Core &Board_, const uint *Cells_, const uint *SetCells_, uint SetSize_, BV IgnoreVals_):
+        Board(Board_), Cells(Cells_), SetCells(SetCells_), SetSize(SetSize_), IgnoreVals(IgnoreVals_) {}
+    
+    bool operator()(const uint *Items, BV SetUnion)
     {
-        byte *AvailPtr1 = Avail[i1];
-        if (VectorSum(AvailPtr1,1,Size) <= 1) continue;
-        for (uint i2=i1+1; i2<Size; i2++)
+        uint Size = Board.GetSideLength();
+        BV OpenUnion = SetUnion | IgnoreVals;
+        bool rc = false;
+        uint iset = 0;
+        for (uint ix=0; ix<Size; ix++)
         {
-            byte *AvailPtr2 = Avail[i2];
-            if (VectorSum(AvailPtr2,1,Size) <= 1) continue;
-            
-            for (uint i3=i2+1; i3<Size; i3++)
-            {
-                byte *AvailPtr3 = Avail[i3];
-                if (VectorSum(AvailPtr3,1,Size) <= 1) continue;
-                
-                for (uint i4=i3+1; i4<Size; i4++)
-                {
-                    byte *AvailPtr4 = Avail[i4];
-                    if (VectorSum(AvailPtr4,1,Size) <= 1) continue;
-                    
-                    // The total visible set
-                    VecCopy(SetUnionPtr,1,Size,AvailPtr1);
-                    VecOrTo(SetUnionPtr,1,Size,AvailPtr2);
-                    VecOrTo(SetUnionPtr,1,Size,AvailPtr3);
-                    VecOrTo(SetUnionPtr,1,Size,AvailPtr4);
-                    // Does it have the right size?
-                    if (VectorSum(SetUnionPtr,1,Size) != 4) continue;
-                    
-                    // Remove the visible set from the others in the row/column/block
-                    bool rc = false;
-                    for (uint ix=0; ix<Size; ix++)
-                    {
-                        if (ix == i1) continue;
-                        if (ix == i2) continue;
-                        if (ix == i3) continue;
-                        if (ix == i4) continue;
-                        if (VecSubFmCheck(Avail[ix],1,Size,SetUnionPtr)) rc = true;
-                    }
-                    if (rc) return true;
-                }
-            }
+            if (iset < SetSize && ix == SetCells[Items[iset]]) {iset++; continue;}
+            BV &CellAvail = Board.Avail(Cells[ix]);
+            if (Board.Remove(Cells[ix],(BitCount(CellAvail) > 1) ? OpenUnion : SetUnion)) rc = true;
         }
+        return rc;
     }
+};
+
+// IgnoreVals are values to leave out of the cells' candidates:
+// the values of singles, when searching for the visible side of a hidden set
+template<class Core> static bool FindVisSets(Core &Board, const uint *Cells, uint SetSize,
+    typename Core::BitVec IgnoreVals)
+{
+    typedef typename Core::BitVec BV;
+    uint Size = Board.GetSideLength();
     
-    return false;
+    // The cells' candidates, skipping over singles to save time
+    BV Masks[8*sizeof(BV)];
+    uint SetCells[8*sizeof(BV)];
+    uint NumItems = 0;
+    for (uint ix=0; ix<Size; ix++)
+    {
+        BV CellAvail = Board.Avail(Cells[ix]);
+        if (BitCount(CellAvail) <= 1) continue;
+        Masks[NumItems] = CellAvail & ~IgnoreVals;
+        SetCells[NumItems] = ix;
+        NumItems++;
+    }
+    
+    VisSetRemover<Core> Remover(Board,Cells,SetCells,SetSize,IgnoreVals);
+    return FindSets(Masks,NumItems,SetSize,Remover);
 }
 
-bool VisFive(byte **Avail, uint Size)
+// For hidden sets: trims the set's cells down to the set's values
+template<class Core> struct HidSetTrimmer
 {
-    vector<byte> SetUnion(Size+1);
-    byte *SetUnionPtr = &SetUnion[0];
+    typedef typename Core::BitVec BV;
+    
+    Core &Board;
+    const uint *Cells;
+    const uint *SetVals;
+    uint SetSize;
+    
+    HidSetTrimmer(Core &Board_, const uint *Cells_, const uint *SetVals_, uint SetSize_):
+        Board(Board_), Cells(Cells_), SetVals(SetVals_), SetSize(SetSize_) {}
     
-    // Skipping over singles to save time
-    for (uint i1=0; i1<Size; i1++)
+    bool operator()(const uint *Items, BV SetUnion)
     {
-        byte *AvailPtr1 = Avail[i1];
-        if (VectorSum(AvailPtr1,1,Size) <= 1) continue;
-        for (uint i2=i1+1; i2<Size; i2++)
+        BV Vals = 0;
+        for (uint iset=0; iset<SetSize; iset++)
+            Vals |= BitSingle<BV>(SetVals[Items[iset]]);
+        BV Others = ~Vals;
+        
+        bool rc = false;
+        while (SetUnion != 0)
         {
-            byte *AvailPtr2 = Avail[i2];
-            if (VectorSum(AvailPtr2,1,Size) <= 1) continue;
-            
-            for (uint i3=i2+1; i3<Size; i3++)
-            {
-                byte *AvailPtr3 = Avail[i3];
-                if (VectorSum(AvailPtr3,1,Size) <= 1) continue;
-                
-                for (uint i4=i3+1; i4<Size; i4++)
-                {
-                    byte *AvailPtr4 = Avail[i4];
-                    if (VectorSum(AvailPtr4,1,Size) <= 1) continue;
-                    
-                    for (uint i5=i4+1; i5<Size; i5++)
-                    {
-                        byte *AvailPtr5 = Avail[i5];
-                        if (VectorSum(AvailPtr5,1,Size) <= 1) continue;
-                       
-                        // The total visible set
-                        VecCopy(SetUnionPtr,1,Size,AvailPtr1);
-                        VecOrTo(SetUnionPtr,1,Size,AvailPtr2);
-                        VecOrTo(SetUnionPtr,1,Size,AvailPtr3);
-                        VecOrTo(SetUnionPtr,1,Size,AvailPtr4);
-                        VecOrTo(SetUnionPtr,1,Size,AvailPtr5);
-                        // Does it have the right size?
-                        if (VectorSum(SetUnionPtr,1,Size) != 5) continue;
-                    
-                        // Remove the visible set from the others in the row/column/block
-                        bool rc = false;
-                        for (uint ix=0; ix<Size; ix++)
-                        {
-                            if (ix == i1) continue;
-                            if (ix == i2) continue;
-                            if (ix == i3) continue;
-                            if (ix == i4) continue;
-                            if (ix == i5) continue;
-                            if (VecSubFmCheck(Avail[ix],1,Size,SetUnionPtr)) rc = true;
-                        }
-                        if (rc) return true;
-                    }
-                }
-            }
+            if (Board.Remove(Cells[BitFirst(SetUnion)],Others)) rc = true;
+            SetUnion = BitClearFirst(SetUnion);
+        }
+        return rc;
+    }
+};
+
+template<class Core> static bool FindHidSets(Core &Board, const uint *Cells, uint SetSize)
+{
+    typedef typename Core::BitVec BV;
+    uint Size = Board.GetSideLength();
+    
+    // Search over values instead of cells: a hidden set is a set of values
+    // that are confined to as many cells. The masks are where each value is,
+    // leaving out the values of singles, since no hidden set can have them
+    BV Masks[8*sizeof(BV)];
+    uint SetVals[8*sizeof(BV)];
+    for (uint ival=0; ival<Size; ival++)
+        Masks[ival] = 0;
+    
+    BV SingleVals = 0;
+    for (uint ix=0; ix<Size; ix++)
+    {
+        BV CellAvail = Board.Avail(Cells[ix]);
+        if (BitCount(CellAvail) <= 1)
+        {
+            SingleVals |= CellAvail;
+            continue;
+        }
+        BV CellBit = BitSingle<BV>(ix);
+        while (CellAvail != 0)
+        {
+            Masks[BitFirst(CellAvail)] |= CellBit;
+            CellAvail = BitClearFirst(CellAvail);
         }
     }
     
-    return false;
+    uint NumItems = 0;
+    for (uint ival=0; ival<Size; ival++)
+    {
+        if (BitTest(SingleVals,ival) || Masks[ival] == 0) continue;
+        Masks[NumItems] = Masks[ival];
+        SetVals[NumItems] = ival;
+        NumItems++;
+    }
+    
+    HidSetTrimmer<Core> Trimmer(Board,Cells,SetVals,SetSize);
+    return FindSets(Masks,NumItems,SetSize,Trimmer);
 }
 
-// Hidden sets
+// In a group with n unsolved cells, a visible set of size k leaves a hidden set
+// of size n - k in the rest of the group: the values that are not in the visible set.
+// Both make the same eliminations, so these search whichever side is smaller,
+// and skip the search if the smaller side has already been searched at its own size.
+// Values of singles are left out on both sides, and if they leave a different number of values
+// than of unsolved cells, the board is contradictory and these search as asked.
 
-bool HidOne(byte **Avail, uint Size)
+template<class Core> static void CountOpen(Core &Board, const uint *Cells,
+    uint &NumCells, uint &NumVals, typename Core::BitVec &SingleVals)
 {
-    vector<byte> SetUnion(Size+1);
-    byte *SetUnionPtr = &SetUnion[0];
-    vector<byte> SetDiff(Size+1);
-    byte *SetDiffPtr = &SetDiff[0];
-   
-    for (uint i=0; i<Size; i++)
+    typedef typename Core::BitVec BV;
+    uint Size = Board.GetSideLength();
+    
+    NumCells = 0;
+    SingleVals = 0;
+    BV OpenVals = 0;
+    for (uint ix=0; ix<Size; ix++)
     {
-        byte *AvailPtr = Avail[i];
-        if (VectorSum(AvailPtr,1,Size) == 0) continue;
-        
-        // Get what's outside the set
-        VecFalse(SetUnionPtr,1,Size);
-        for (uint ix=0; ix<Size; ix++)
+        BV CellAvail = Board.Avail(Cells[ix]);
+        if (BitCount(CellAvail) <= 1)
+            SingleVals |= CellAvail;
+        else
         {
-            if (ix == i) continue;
-            VecOrTo(SetUnionPtr,1,Size,Avail[ix]);
+            OpenVals |= CellAvail;
+            NumCells++;
         }
-        
-        // Get the set's contents
-        // Remove outside the set from inside it
-        VecSub(SetDiffPtr,1,Size,AvailPtr,SetUnionPtr);
-        // The right size?
-        if (VectorSum(SetDiffPtr,1,Size) != 1) continue;
-        
-        // Trim down the set
-        VecNotAt(SetDiffPtr,1,Size);
-        if (VecSubFmCheck(AvailPtr,1,Size,SetDiffPtr)) return true;
     }
+    OpenVals &= ~SingleVals;
+    NumVals = BitCount(OpenVals);
+}
+
+template<class Core> bool VisSets(Core &Board, const uint *Cells, uint SetSize)
+{
+    typedef typename Core::BitVec BV;
     
-    return false;
+    uint NumCells, NumVals;
+    BV SingleVals;
+    CountOpen(Board,Cells,NumCells,NumVals,SingleVals);
+    if (SetSize >= NumCells) return false;
+    
+    uint DualSize = NumCells - SetSize;
+    if (NumVals != NumCells || DualSize >= SetSize) return FindVisSets(Board,Cells,SetSize,BV(0));
+    if (DualSize <= Board.GetMaxHidSetSize()) return false;
+    return FindHidSets(Board,Cells,DualSize);
+}
+
+template<class Core> bool HidSets(Core &Board, const uint *Cells, uint SetSize)
+{
+    typedef typename Core::BitVec BV;
+    
+    uint NumCells, NumVals;
+    BV SingleVals;
+    CountOpen(Board,Cells,NumCells,NumVals,SingleVals);
+    if (SetSize > NumVals) return false;
+    
+    // One with all the values can still clear out the values of singles
+    uint DualSize = NumVals - SetSize;
+    if (NumVals != NumCells || DualSize == 0 || DualSize >= SetSize) return FindHidSets(Board,Cells,SetSize);
+    if (DualSize <= Board.GetMaxVisSetSize()) return false;
+    return FindVisSets(Board,Cells,DualSize,SingleVals);
 }
 
-bool HidTwo(byte **Avail, uint Size)
+
+template<class Core> bool ItscBlkStrip(Core &Board, uint itech, const IntersectionTable &Table)
 {
-    vector<byte> SetUnion(Size+1);
-    byte *SetUnionPtr = &SetUnion[0];
-    vector<byte> SetDiff(Size+1);
-    byte *SetDiffPtr = &SetDiff[0];
+    typedef typename Core::BitVec BV;
+    TechniquePass<Core> Pass(Board,itech);
+    
+    // Set up
+    uint SegLength = Table.SegLength;
+    uint RestLength = Board.GetSideLength() - SegLength;
+    
+    BV SetSeg;
+    BV SetStrip;
+    BV SetBlk;
     
-    // Skipping over singles to save time
-    for (uint i1=0; i1<Size; i1++)
+    BV SetDiffStrip;
+    BV SetDiffBlk;
+    
+    // Iterate over the blocks
+    uint NumItsc = (uint)Table.BlockGroups.size();
+    for (uint iitmin=0; iitmin<NumItsc; iitmin+=Table.NumPerBlock)
     {
-        byte *AvailPtr1 = Avail[i1];
-        if (VectorSum(AvailPtr1,1,Size) <= 1) continue;
+        uint iitmax = iitmin + Table.NumPerBlock;
         
-        for (uint i2=i1+1; i2<Size; i2++)
+        // Skip the block if neither it nor its strips have changed
+        // since it was last checked
+        uint igrp = Table.BlockGroups[iitmin];
+        size_t LatestChange = Board.GroupChange(igrp);
+        for (uint iitsc=iitmin; iitsc<iitmax; iitsc++)
+            LatestChange = max(LatestChange,Board.GroupChange(Table.StripGroups[iitsc]));
+        if (!Board.NeedsCheck(itech,igrp,LatestChange)) continue;
+        
+        // Iterate over strips in the block
+        for (uint iitsc=iitmin; iitsc<iitmax; iitsc++)
         {
-            byte *AvailPtr2 = Avail[i2];
-            if (VectorSum(AvailPtr2,1,Size) <= 1) continue;
+            const uint *SegCells = &Table.Cells[Table.Stride*iitsc];
+            const uint *StripRest = SegCells + SegLength;
+            const uint *BlockRest = StripRest + RestLength;
             
-            // Get what's outside of the set
-            VecFalse(SetUnionPtr,1,Size);
-            for (uint ix=0; ix<Size; ix++)
+            // Find the segment availability
+            SetSeg = 0;
+            uint numseg = 0;
+            for (uint ix=0; ix<SegLength; ix++)
             {
-                if (ix == i1) continue;
-                if (ix == i2) continue;
-                VecOrTo(SetUnionPtr,1,Size,Avail[ix]);
+                BV *AvailPtr = &Board.Avail(SegCells[ix]);
+                if (BitCount(*AvailPtr) <= 1) continue;
+                SetSeg |= *AvailPtr;
+                numseg++;
             }
+            if (numseg == 0) continue;
             
-            // Get the set's contents
-            VecCopy(SetDiffPtr,1,Size,AvailPtr1);
-            VecOrTo(SetDiffPtr,1,Size,AvailPtr2);
+            // Find the strip availability
+            SetStrip = 0;
+            for (uint ix=0; ix<RestLength; ix++)
+            {
+                BV *AvailPtr = &Board.Avail(StripRest[ix]);
+                if (BitCount(*AvailPtr) <= 1) continue;
+                SetStrip |= *AvailPtr;
+            }
             
-            // Remove outside the set from inside it
-            VecSubFm(SetDiffPtr,1,Size,SetUnionPtr);
-            // The right size?
-            if (VectorSum(SetDiffPtr,1,Size) != 2) continue;
+            // Find the block availability
+            SetBlk = 0;
+            for (uint ix=0; ix<RestLength; ix++)
+            {
+                BV *AvailPtr = &Board.Avail(BlockRest[ix]);
+                if (BitCount(*AvailPtr) <= 1) continue;
+                SetBlk |= *AvailPtr;
+            }
             
-            // Trim down the set
-            VecNotAt(SetDiffPtr,1,Size);
-            bool rc = false;
-            if (VecSubFmCheck(AvailPtr1,1,Size,SetDiffPtr)) rc = true;
-            if (VecSubFmCheck(AvailPtr2,1,Size,SetDiffPtr)) rc = true;
-            if (rc) return true;
+            // Find the block-clearing availability
+            SetDiffStrip = SetSeg & ~SetStrip;
+            uint dfstrlen = BitCount(SetDiffStrip);
+            
+            // Clear the non-segment part of the block
+            if (dfstrlen > 0 && dfstrlen <= numseg)
+            {
+                bool rc = false;
+                for (uint ix=0; ix<RestLength; ix++)
+                {
+                    if (Board.Remove(BlockRest[ix],SetDiffStrip)) rc = true;
+                }
+                if (rc) return true;
+            }
+            
+            // Find the strip-clearing availability
+            SetDiffBlk = SetSeg & ~SetBlk;
+            uint dfblklen = BitCount(SetDiffBlk);
+            
+            // Clear the non-segment part of the strip
+            if (dfblklen > 0 && dfblklen <= numseg)
+            {
+                bool rc = false;
+                for (uint ix=0; ix<RestLength; ix++)
+                {
+                    if (Board.Remove(StripRest[ix],SetDiffBlk)) rc = true;
+                }
+                if (rc) return true;
+            }
         }
+        
+        // Nothing to do here until something changes
+        Board.SetChecked(itech,igrp);
     }
     
     return false;
 }
 
-bool HidThree(byte **Avail, uint Size)
+
+template<class Core> bool Itsc(Core &Board)
+{
+    if (ItscBlkStrip(Board,TechItscBlkRow,Board.RowIntersections())) return true;
+    if (ItscBlkStrip(Board,TechItscBlkCol,Board.ColIntersections())) return true;
+    
+    return false;
+}
+
+
+// Fish: for some value, n rows whose cells with it are all in the same n columns.
+// The value must be in those columns in those rows, so it can be cleared from the rest of those columns.
+// Likewise with rows and columns exchanged. Size 2 is the X-Wing, 3 the Swordfish, and 4 the Jellyfish.
+// It is a hidden set over lines instead of cells, so it uses the same search,
+// with position masks: for each line, the lines across it where it has the value.
+
+// Clears the value from the fish's cover lines outside its base lines
+template<class Core> struct FishRemover
 {
-    vector<byte> SetUnion(Size+1);
-    byte *SetUnionPtr = &SetUnion[0];
-    vector<byte> SetDiff(Size+1);
-    byte *SetDiffPtr = &SetDiff[0];
+    typedef typename Core::BitVec BV;
+    
+    Core &Board;
+    const uint *Lines;
+    uint FishSize;
+    bool IsCols;
+    uint ival;
     
-    // Skipping over singles to save time
-    for (uint i1=0; i1<Size; i1++)
+    FishRemover(Core &Board_, const uint *Lines_, uint FishSize_, bool IsCols_):
+        Board(Board_), Lines(Lines_), FishSize(FishSize_), IsCols(IsCols_), ival(0) {}
+    
+    bool operator()(const uint *Items, BV SetUnion)
     {
-        byte *AvailPtr1 = Avail[i1];
-        if (VectorSum(AvailPtr1,1,Size) <= 1) continue;
+        uint Size = Board.GetSideLength();
+        BV BaseLines = 0;
+        for (uint iset=0; iset<FishSize; iset++)
+            BaseLines |= BitSingle<BV>(Lines[Items[iset]]);
+        BV ValBit = BitSingle<BV>(ival);
         
-        for (uint i2=i1+1; i2<Size; i2++)
+        bool rc = false;
+        while (SetUnion != 0)
         {
-            byte *AvailPtr2 = Avail[i2];
-            if (VectorSum(AvailPtr2,1,Size) <= 1) continue;
-            
-            for (uint i3=i2+1; i3<Size; i3++)
+            uint icover = BitFirst(SetUnion);
+            for (uint iline=0; iline<Size; iline++)
             {
-                byte *AvailPtr3 = Avail[i3];
-                if (VectorSum(AvailPtr3,1,Size) <= 1) continue;
-                
-                // Get what's outside of the set
-                VecFalse(SetUnionPtr,1,Size);
-                for (uint ix=0; ix<Size; ix++)
-                {
-                    if (ix == i1) continue;
-                    if (ix == i2) continue;
-                    if (ix == i3) continue;
-                    VecOrTo(SetUnionPtr,1,Size,Avail[ix]);
-                }
-                
-                // Get the set's contents
-                VecCopy(SetDiffPtr,1,Size,AvailPtr1);
-                VecOrTo(SetDiffPtr,1,Size,AvailPtr2);
-                VecOrTo(SetDiffPtr,1,Size,AvailPtr3);
-                
-                // Remove outside the set from inside it
-                VecSubFm(SetDiffPtr,1,Size,SetUnionPtr);
-                // The right size?
-                if (VectorSum(SetDiffPtr,1,Size) != 3) continue;
-                
-                // Trim down the set
-                VecNotAt(SetDiffPtr,1,Size);
-                bool rc = false;
-                if (VecSubFmCheck(AvailPtr1,1,Size,SetDiffPtr)) rc = true;
-                if (VecSubFmCheck(AvailPtr2,1,Size,SetDiffPtr)) rc = true;
-                if (VecSubFmCheck(AvailPtr3,1,Size,SetDiffPtr)) rc = true;
-                if (rc) return true;
+                if (BitTest(BaseLines,iline)) continue;
+                uint icell = IsCols ? Size*icover + iline : Size*iline + icover;
+                if (Board.Remove(icell,ValBit)) rc = true;
             }
+            SetUnion = BitClearFirst(SetUnion);
         }
+        return rc;
     }
-    
-    return false;
-}
+};
 
-bool HidFour(byte **Avail, uint Size)
+// IsCols: whether the base lines are columns instead of rows
+template<class Core> bool FishLines(Core &Board, uint FishSize, bool IsCols)
 {
-    vector<byte> SetUnion(Size+1);
-    byte *SetUnionPtr = &SetUnion[0];
-    vector<byte> SetDiff(Size+1);
-    byte *SetDiffPtr = &SetDiff[0];
+    typedef typename Core::BitVec BV;
+    uint itech = TechFish(Board.GetMaxSetSize(),FishSize,IsCols);
+    TechniquePass<Core> Pass(Board,itech);
+    
+    // A fish can involve the whole board, so check again after any change
+    if (!Board.NeedsCheck(itech,0,Board.BoardChange())) return false;
     
-    // Skipping over singles to save time
-    for (uint i1=0; i1<Size; i1++)
+    uint Size = Board.GetSideLength();
+    BV Masks[8*sizeof(BV)];
+    uint Lines[8*sizeof(BV)];
+    FishRemover<Core> Remover(Board,Lines,FishSize,IsCols);
+    
+    for (uint ival=0; ival<Size; ival++)
     {
-        byte *AvailPtr1 = Avail[i1];
-        if (VectorSum(AvailPtr1,1,Size) <= 1) continue;
-        
-        for (uint i2=i1+1; i2<Size; i2++)
+        // The lines that the value is still open in, leaving out the ones where it is solved,
+        // and the ones where it has too many places to be in a fish of this size,
+        // which the index of places finds without looking at their cells
+        uint NumItems = 0, NumOpen = 0;
+        for (uint iline=0; iline<Size; iline++)
         {
-            byte *AvailPtr2 = Avail[i2];
-            if (VectorSum(AvailPtr2,1,Size) <= 1) continue;
+            uint igrp = IsCols ? Board.ColGroup(iline) : Board.RowGroup(iline);
+            if (Board.NumPlaces(igrp,ival) > FishSize) {NumOpen++; continue;}
             
-            for (uint i3=i2+1; i3<Size; i3++)
+            BV Mask = 0;
+            bool IsSolved = false;
+            for (uint icross=0; icross<Size; icross++)
             {
-                byte *AvailPtr3 = Avail[i3];
-                if (VectorSum(AvailPtr3,1,Size) <= 1) continue;
-                
-                for (uint i4=i3+1; i4<Size; i4++)
-                {
-                    byte *AvailPtr4 = Avail[i4];
-                    if (VectorSum(AvailPtr4,1,Size) <= 1) continue;
-                    
-                    // Get what's outside of the set
-                    VecFalse(SetUnionPtr,1,Size);
-                    for (uint ix=0; ix<Size; ix++)
-                    {
-                        if (ix == i1) continue;
-                        if (ix == i2) continue;
-                        if (ix == i3) continue;
-                        if (ix == i4) continue;
-                        VecOrTo(SetUnionPtr,1,Size,Avail[ix]);
-                    }
-                    
-                    // Get the set's contents
-                    VecCopy(SetDiffPtr,1,Size,AvailPtr1);
-                    VecOrTo(SetDiffPtr,1,Size,AvailPtr2);
-                    VecOrTo(SetDiffPtr,1,Size,AvailPtr3);
-                    VecOrTo(SetDiffPtr,1,Size,AvailPtr4);
-                    
-                    // Remove outside the set from inside it
-                    VecSubFm(SetDiffPtr,1,Size,SetUnionPtr);
-                    // The right size?
-                    if (VectorSum(SetDiffPtr,1,Size) != 4) continue;
-                    
-                    // Trim down the set
-                    VecNotAt(SetDiffPtr,1,Size);
-                    bool rc = false;
-                    if (VecSubFmCheck(AvailPtr1,1,Size,SetDiffPtr)) rc = true;
-                    if (VecSubFmCheck(AvailPtr2,1,Size,SetDiffPtr)) rc = true;
-                    if (VecSubFmCheck(AvailPtr3,1,Size,SetDiffPtr)) rc = true;
-                    if (VecSubFmCheck(AvailPtr4,1,Size,SetDiffPtr)) rc = true;
-                    if (rc) return true;
-                }
+                BV CellAvail = IsCols ? Board.Avail(icross,iline) : Board.Avail(iline,icross);
+                if (!BitTest(CellAvail,ival)) continue;
+                if (BitCount(CellAvail) <= 1) {IsSolved = true; break;}
+                Mask |= BitSingle<BV>(icross);
             }
+            if (IsSolved || Mask == 0) continue;
+            NumOpen++;
+            Masks[NumItems] = Mask;
+            Lines[NumItems] = iline;
+            NumItems++;
         }
+        
+        // A fish in all the open lines has nowhere else to clear the value from
+        if (NumOpen <= FishSize) continue;
+        Remover.ival = ival;
+        if (FindSets(Masks,NumItems,FishSize,Remover)) return true;
     }
     
+    // Nothing to do here until something changes
+    Board.SetChecked(itech,0);
+    return false;
+}
+
+template<class Core> bool Fish(Core &Board, uint FishSize)
+{
+    if (FishLines(Board,FishSize,false)) return true;
+    if (FishLines(Board,FishSize,true)) return true;
+    
     return false;
 }
 
-bool HidFive(byte **Avail, uint Size)
+
+// Wings: a pivot cell and two bivalue pincer cells that it sees, which share a value z.
+// In an XY-Wing, the pivot has two values x and y, and the pincers have x and z, and y and z.
+// Whichever value the pivot has, one of the pincers has z, so no cell that sees both pincers can have it.
+// In an XYZ-Wing, the pivot has x, y, and z, so it may be the one with z,
+// and only the cells that see the pivot as well can have z removed.
+// The pincers come from the bivalue-cell index, so only the pivot's peers get looked at.
+
+// The bivalue cells that a pivot sees whose values overlap the pivot's as the wing needs:
+// one of them for an XY-Wing and both of them for an XYZ-Wing
+template<class Core> static uint FindPincers(Core &Board, uint ipivot, uint NumShared, uint *Pincers)
+{
+    typedef typename Core::BitVec BV;
+    BV PivotAvail = Board.Avail(ipivot);
+    uint NumPeers = Board.GetNumPeers();
+    const uint *Peers = Board.Peers(ipivot);
+    
+    uint NumPincers = 0;
+    for (uint ip=0; ip<NumPeers; ip++)
+    {
+        uint icell = Peers[ip];
+        if (!Board.IsBivalue(icell)) continue;
+        if (BitCount(BV(Board.Avail(icell) & PivotAvail)) != NumShared) continue;
+        Pincers[NumPincers++] = icell;
+    }
+    return NumPincers;
+}
+
+template<class Core> bool XYWing(Core &Board)
 {
-    vector<byte> SetUnion(Size+1);
-    byte *SetUnionPtr = &SetUnion[0];
-    vector<byte> SetDiff(Size+1);
-    byte *SetDiffPtr = &SetDiff[0];
+    typedef typename Core::BitVec BV;
+    TechniquePass<Core> Pass(Board,TechXYWing);
+    if (!Board.NeedsCheck(TechXYWing,0,Board.BoardChange())) return false;
     
-    // Skipping over singles to save time
-    for (uint i1=0; i1<Size; i1++)
+    uint BoardSize = Board.GetBoardSize();
+    uint NumPeers = Board.GetNumPeers();
+    vector<uint> Pincers(NumPeers);
+    for (uint ipivot=0; ipivot<BoardSize; ipivot++)
     {
-        byte *AvailPtr1 = Avail[i1];
-        if (VectorSum(AvailPtr1,1,Size) <= 1) continue;
+        if (!Board.IsBivalue(ipivot)) continue;
+        BV PivotAvail = Board.Avail(ipivot);
+        uint NumPincers = FindPincers(Board,ipivot,1,Pincers.data());
         
-        for (uint i2=i1+1; i2<Size; i2++)
-        {
-            byte *AvailPtr2 = Avail[i2];
-            if (VectorSum(AvailPtr2,1,Size) <= 1) continue;
-            
-            for (uint i3=i2+1; i3<Size; i3++)
+        for (uint ia=0; ia<NumPincers; ia++)
+            for (uint ib=ia+1; ib<NumPincers; ib++)
             {
-                byte *AvailPtr3 = Avail[i3];
-                if (VectorSum(AvailPtr3,1,Size) <= 1) continue;
+                // They must share z and have different values of the pivot's
+                uint icella = Pincers[ia], icellb = Pincers[ib];
+                BV AvailA = Board.Avail(icella), AvailB = Board.Avail(icellb);
+                BV ZVal = AvailA & ~PivotAvail;
+                if ((AvailB & ~PivotAvail) != ZVal || (AvailA & PivotAvail) == (AvailB & PivotAvail)) continue;
                 
-                for (uint i4=i3+1; i4<Size; i4++)
-                {
-                    byte *AvailPtr4 = Avail[i4];
-                    if (VectorSum(AvailPtr4,1,Size) <= 1) continue;
-                    
-                    for (uint i5=i4+1; i5<Size; i5++)
-                    {
-                        byte *AvailPtr5 = Avail[i5];
-                        if (VectorSum(AvailPtr5,1,Size) <= 1) continue;
-
-                        // Get what's outside of the set
-                        VecFalse(SetUnionPtr,1,Size);
-                        for (uint ix=0; ix<Size; ix++)
-                        {
-                            if (ix == i1) continue;
-                            if (ix == i2) continue;
-                            if (ix == i3) continue;
-                            if (ix == i4) continue;
-                            if (ix == i5) continue;
-                            VecOrTo(SetUnionPtr,1,Size,Avail[ix]);
-                        }
-                    
-                        // Get the set's contents
-                        VecCopy(SetDiffPtr,1,Size,AvailPtr1);
-                        VecOrTo(SetDiffPtr,1,Size,AvailPtr2);
-                        VecOrTo(SetDiffPtr,1,Size,AvailPtr3);
-                        VecOrTo(SetDiffPtr,1,Size,AvailPtr4);
-                        VecOrTo(SetDiffPtr,1,Size,AvailPtr5);
-                        
-                        // Remove outside the set from inside it
-                        VecSubFm(SetDiffPtr,1,Size,SetUnionPtr);
-                        // The right size?
-                        if (VectorSum(SetDiffPtr,1,Size) != 5) continue;
-                        
-                        // Trim down the set
-                        VecNotAt(SetDiffPtr,1,Size);
-                        bool rc = false;
-                        if (VecSubFmCheck(AvailPtr1,1,Size,SetDiffPtr)) rc = true;
-                        if (VecSubFmCheck(AvailPtr2,1,Size,SetDiffPtr)) rc = true;
-                        if (VecSubFmCheck(AvailPtr3,1,Size,SetDiffPtr)) rc = true;
-                        if (VecSubFmCheck(AvailPtr4,1,Size,SetDiffPtr)) rc = true;
-                        if (VecSubFmCheck(AvailPtr5,1,Size,SetDiffPtr)) rc = true;
-                        if (rc) return true;
-                    }
-                }
+                bool rc = false;
+                const uint *Peers = Board.Peers(icella);
+                for (uint ip=0; ip<NumPeers; ip++)
+                    if (Board.Sees(Peers[ip],icellb) && Board.Remove(Peers[ip],ZVal)) rc = true;
+                if (rc) return true;
             }
-        }
     }
     
+    // Nothing to do here until something changes
+    Board.SetChecked(TechXYWing,0);
     return false;
 }
 
-
-// Intersections between blocks, rows, and columns
-// Pointing sets
-
-bool ItscBlkRow(BoardManager &Board)
+template<class Core> bool XYZWing(Core &Board)
 {
-    // Set up
-    uint BlockRows = Board.GetBlockRows();
-    uint BlockCols = Board.GetBlockCols();
-    uint SideLength = Board.GetSideLength();
-    
-    vector<byte> SetSeg(SideLength+1);
-    byte *SetSegPtr = &SetSeg[0];
-    vector<byte> SetRow(SideLength+1);
-    byte *SetRowPtr = &SetRow[0];
-    vector<byte> SetBlk(SideLength+1);
-    byte *SetBlkPtr = &SetBlk[0];
-    
-    vector<byte> SetDiffRow(SideLength+1);
-    byte *SetDiffRowPtr = &SetDiffRow[0];
-    vector<byte> SetDiffBlk(SideLength+1);
-    byte *SetDiffBlkPtr = &SetDiffBlk[0];
+    typedef typename Core::BitVec BV;
+    TechniquePass<Core> Pass(Board,TechXYZWing);
+    if (!Board.NeedsCheck(TechXYZWing,0,Board.BoardChange())) return false;
     
-    // Iterate over the blocks
-    for (uint ibkrow=0; ibkrow<BlockCols; ibkrow++)
+    uint BoardSize = Board.GetBoardSize();
+    uint NumPeers = Board.GetNumPeers();
+    vector<uint> Pincers(NumPeers);
+    for (uint ipivot=0; ipivot<BoardSize; ipivot++)
     {
-        uint ibkrwmin = BlockRows*ibkrow;
-        uint ibkrwmax = ibkrwmin + BlockRows;
-        for (uint ibkcol=0; ibkcol<BlockRows; ibkcol++)
-        {
-            uint ibkclmin = BlockCols*ibkcol;
-            uint ibkclmax = ibkclmin + BlockCols;
-            
-            // Iterate over rows in the block
-            for (uint irow = ibkrwmin; irow<ibkrwmax; irow++)
+        if (BitCount(Board.Avail(ipivot)) != 3) continue;
+        uint NumPincers = FindPincers(Board,ipivot,2,Pincers.data());
+        
+        for (uint ia=0; ia<NumPincers; ia++)
+            for (uint ib=ia+1; ib<NumPincers; ib++)
             {
-                // Find the segment availability
-                VecFalse(SetSegPtr,1,SideLength);
-                uint numseg = 0;
-                for (uint icol=ibkclmin; icol<ibkclmax; icol++)
-                {
-                    byte *AvailPtr = &Board.Avail(irow,icol,0);
-                    if (VectorSum(AvailPtr,1,SideLength) <= 1) continue;
-                    VecOrTo(SetSegPtr,1,SideLength,AvailPtr);
-                    numseg++;
-                }
-                if (numseg == 0) continue;
-                
-                // Find the row availability
-                VecFalse(SetRowPtr,1,SideLength);
-                for (uint icol=0; icol<SideLength; icol++)
-                {
-                    if (icol>=ibkclmin && icol<ibkclmax) continue;
-                    byte *AvailPtr = &Board.Avail(irow,icol,0);
-                    if (VectorSum(AvailPtr,1,SideLength) <= 1) continue;
-                    VecOrTo(SetRowPtr,1,SideLength,AvailPtr);
-                }
-                
-                // Find the block availability
-                VecFalse(SetBlkPtr,1,SideLength);
-                for (uint irwx=ibkrwmin; irwx<ibkrwmax; irwx++)
-                {
-                    if (irwx == irow) continue;
-                    for (uint icol=ibkclmin; icol<ibkclmax; icol++)
-                    {
-                        byte *AvailPtr = &Board.Avail(irwx,icol,0);
-                        if (VectorSum(AvailPtr,1,SideLength) <= 1) continue;
-                        VecOrTo(SetBlkPtr,1,SideLength,AvailPtr);
-                    }
-                }
-                
-                // Find the block-clearing availability
-                VecSub(SetDiffRowPtr,1,SideLength,SetSegPtr,SetRowPtr);
-                uint dfrowlen = VectorSum(SetDiffRowPtr,1,SideLength);
-                
-                // Clear the non-segment part of the block
-                if (dfrowlen > 0 && dfrowlen <= numseg)
-                {
-                    bool rc = false;
-                    for (uint irwx=ibkrwmin; irwx<ibkrwmax; irwx++)
-                    {
-                        if (irwx == irow) continue;
-                        for (uint icol=ibkclmin; icol<ibkclmax; icol++)
-                        {
-                            byte *AvailPtr = &Board.Avail(irwx,icol,0);
-                            if (VecSubFmCheck(AvailPtr,1,SideLength,SetDiffRowPtr)) rc = true;
-                        }
-                    }
-                    if (rc) return true;
-                }
-               
-                // Find the row-clearing availability
-                VecSub(SetDiffBlkPtr,1,SideLength,SetSegPtr,SetBlkPtr);
-                uint dfblklen = VectorSum(SetDiffBlkPtr,1,SideLength);
+                // Two different pairs of the pivot's three values share one of them
+                uint icella = Pincers[ia], icellb = Pincers[ib];
+                BV ZVal = Board.Avail(icella) & Board.Avail(icellb);
+                if (BitCount(ZVal) != 1) continue;
                 
-                // Clear the non-segment part of the row
-                if (dfblklen > 0 && dfblklen <= numseg)
+                bool rc = false;
+                const uint *Peers = Board.Peers(ipivot);
+                for (uint ip=0; ip<NumPeers; ip++)
                 {
-                    bool rc = false;
-                    for (uint icol=0; icol<SideLength; icol++)
-                    {
-                        if (icol>=ibkclmin && icol<ibkclmax) continue;
-                        byte *AvailPtr = &Board.Avail(irow,icol,0);
-                        if (VecSubFmCheck(AvailPtr,1,SideLength,SetDiffBlkPtr)) rc = true;
-                    }
-                    if (rc) return true;
+                    uint icell = Peers[ip];
+                    if (Board.Sees(icell,icella) && Board.Sees(icell,icellb) && Board.Remove(icell,ZVal)) rc = true;
                 }
+                if (rc) return true;
             }
-        }
     }
     
+    // Nothing to do here until something changes
+    Board.SetChecked(TechXYZWing,0);
     return false;
 }
 
-bool ItscBlkCol(BoardManager &Board)
+
+// Single-digit coloring: for some value, a group with only two places for it has it in exactly one of them,
+// so those two places are a conjugate pair. Chains of those pairs can be colored with two colors,
+// and all the places of one color have the value and all the others do not.
+// If two places of the same color share a group, that color is the one without the value.
+// Otherwise, a cell that sees places of both colors cannot have the value.
+// The conjugate pairs come from the count of each value's places in each group.
+
+template<class Core> bool Coloring(Core &Board)
 {
-    // Set up
-    uint BlockRows = Board.GetBlockRows();
-    uint BlockCols = Board.GetBlockCols();
-    uint SideLength = Board.GetSideLength();
-    
-    vector<byte> SetSeg(SideLength+1);
-    byte *SetSegPtr = &SetSeg[0];
-    vector<byte> SetCol(SideLength+1);
-    byte *SetColPtr = &SetCol[0];
-    vector<byte> SetBlk(SideLength+1);
-    byte *SetBlkPtr = &SetBlk[0];
-    
-    vector<byte> SetDiffCol(SideLength+1);
-    byte *SetDiffColPtr = &SetDiffCol[0];
-    vector<byte> SetDiffBlk(SideLength+1);
-    byte *SetDiffBlkPtr = &SetDiffBlk[0];
+    typedef typename Core::BitVec BV;
+    TechniquePass<Core> Pass(Board,TechColoring);
+    if (!Board.NeedsCheck(TechColoring,0,Board.BoardChange())) return false;
     
-    // Iterate over the blocks
-    for (uint ibkrow=0; ibkrow<BlockCols; ibkrow++)
+    const uint NoCell = ~0U;
+    uint Size = Board.GetSideLength();
+    uint BoardSize = Board.GetBoardSize();
+    uint NumGroups = Board.GetNumGroups();
+    uint NumPeers = Board.GetNumPeers();
+    
+    // Each cell's partners in its row, column, and block, or NoCell.
+    // The cells colored so far, with each chain's cells together, and each one's color: 2*chain + which, or NoCell.
+    // The chain numbers run on from one value to the next, so the marks need no clearing:
+    // for each cell and each group, the latest chain with a place of each color that it sees or has
+    vector<uint> Links(3*BoardSize);
+    vector<uint> Colored;
+    vector<uint> Colors(BoardSize,NoCell);
+    vector<uint> CellMarks(BoardSize,NoCell), GroupMarks(2*NumGroups,NoCell);
+    uint NumChains = 0;
+    
+    for (uint ival=0; ival<Size; ival++)
     {
-        uint ibkrwmin = BlockRows*ibkrow;
-        uint ibkrwmax = ibkrwmin + BlockRows;
-        for (uint ibkcol=0; ibkcol<BlockRows; ibkcol++)
+        BV ValBit = BitSingle<BV>(ival);
+        for (size_t iq=0; iq<Colored.size(); iq++)
+            Colors[Colored[iq]] = NoCell;
+        Colored.clear();
+        
+        // Link the conjugate pairs, leaving out solved cells
+        fill(Links.begin(),Links.end(),NoCell);
+        for (uint igrp=0; igrp<NumGroups; igrp++)
+        {
+            if (Board.NumPlaces(igrp,ival) != 2) continue;
+            const uint *Cells = Board.GroupCells(igrp);
+            uint Pair[2], NumFound = 0;
+            for (uint ix=0; ix<Size && NumFound<2; ix++)
+                if (BitTest(Board.Avail(Cells[ix]),ival)) Pair[NumFound++] = Cells[ix];
+            if (BitCount(Board.Avail(Pair[0])) <= 1 || BitCount(Board.Avail(Pair[1])) <= 1) continue;
+            uint ikind = igrp/Size;
+            Links[3*Pair[0]+ikind] = Pair[1];
+            Links[3*Pair[1]+ikind] = Pair[0];
+        }
+        
+        for (uint istart=0; istart<BoardSize; istart++)
         {
-            uint ibkclmin = BlockCols*ibkcol;
-            uint ibkclmax = ibkclmin + BlockCols;
+            if (Colors[istart] != NoCell) continue;
+            if (Links[3*istart] == NoCell && Links[3*istart+1] == NoCell && Links[3*istart+2] == NoCell) continue;
             
-            // Iterate over columns in the block
-            for (uint icol = ibkclmin; icol<ibkclmax; icol++)
+            // Color the chain, breadth first
+            uint ichain = NumChains++;
+            size_t ChainStart = Colored.size();
+            Colors[istart] = 2*ichain;
+            Colored.push_back(istart);
+            for (size_t iq=ChainStart; iq<Colored.size(); iq++)
             {
-                // Find the segment availability
-                VecFalse(SetSegPtr,1,SideLength);
-                uint numseg = 0;
-                for (uint irow=ibkrwmin; irow<ibkrwmax; irow++)
-                {
-                    byte *AvailPtr = &Board.Avail(irow,icol,0);
-                    if (VectorSum(AvailPtr,1,SideLength) <= 1) continue;
-                    VecOrTo(SetSegPtr,1,SideLength,AvailPtr);
-                    numseg++;
-                }
-                if (numseg == 0) continue;
-               
-                // Find the column availability
-                VecFalse(SetColPtr,1,SideLength);
-                for (uint irow=0; irow<SideLength; irow++)
-                {
-                    if (irow>=ibkrwmin && irow<ibkrwmax) continue;
-                    byte *AvailPtr = &Board.Avail(irow,icol,0);
-                    if (VectorSum(AvailPtr,1,SideLength) <= 1) continue;
-                    VecOrTo(SetColPtr,1,SideLength,AvailPtr);
-                }
-                
-                // Find the block availability
-                VecFalse(SetBlkPtr,1,SideLength);
-                for (uint iclx = ibkclmin; iclx<ibkclmax; iclx++)
-                {
-                    if (iclx == icol) continue;
-                    for (uint irow=ibkrwmin; irow<ibkrwmax; irow++)
-                    {
-                        byte *AvailPtr = &Board.Avail(irow,iclx,0);
-                        if (VectorSum(AvailPtr,1,SideLength) <= 1) continue;
-                        VecOrTo(SetBlkPtr,1,SideLength,AvailPtr);
-                    }
-                }
-                
-                // Find the block-clearing availability
-                VecSub(SetDiffColPtr,1,SideLength,SetSegPtr,SetColPtr);
-                uint dfcollen = VectorSum(SetDiffColPtr,1,SideLength);
-                
-                // Clear the non-segment part of the block
-                if (dfcollen > 0 && dfcollen <= numseg)
+                uint icell = Colored[iq];
+                for (uint ik=0; ik<3; ik++)
                 {
-                    bool rc = false;
-                    for (uint iclx = ibkclmin; iclx<ibkclmax; iclx++)
-                    {
-                        if (iclx == icol) continue;
-                        for (uint irow=ibkrwmin; irow<ibkrwmax; irow++)
-                        {
-                            byte *AvailPtr = &Board.Avail(irow,iclx,0);
-                            if (VecSubFmCheck(AvailPtr,1,SideLength,SetDiffColPtr)) rc = true;
-                        }
-                        if (rc) return true;
-                    }
+                    uint iother = Links[3*icell+ik];
+                    if (iother == NoCell || Colors[iother] != NoCell) continue;
+                    Colors[iother] = Colors[icell] ^ 1;
+                    Colored.push_back(iother);
                 }
-                
-                // Find the column-clearing availability
-                VecSub(SetDiffBlkPtr,1,SideLength,SetSegPtr,SetBlkPtr);
-                uint dfblklen = VectorSum(SetDiffBlkPtr,1,SideLength);
-                
-                // Clear the non-segment part of the column
-                if (dfblklen > 0 && dfblklen <= numseg)
+            }
+            
+            // Two places of the same color in a group
+            uint BadColor = NoCell;
+            for (size_t iq=ChainStart; iq<Colored.size() && BadColor == NoCell; iq++)
+            {
+                uint icell = Colored[iq];
+                uint Which = Colors[icell] & 1;
+                const uint *Groups = Board.CellGroups(icell);
+                for (uint ig=0; ig<3; ig++)
                 {
-                    bool rc = false;
-                    for (uint irow=0; irow<SideLength; irow++)
-                    {
-                        if (irow>=ibkrwmin && irow<ibkrwmax) continue;
-                        byte *AvailPtr = &Board.Avail(irow,icol,0);
-                        if (VecSubFmCheck(AvailPtr,1,SideLength,SetDiffBlkPtr)) rc = true;
-                    }
-                    if (rc) return true;
+                    uint &Mark = GroupMarks[2*Groups[ig]+Which];
+                    if (Mark == ichain) {BadColor = Which; break;}
+                    Mark = ichain;
                 }
             }
+            if (BadColor != NoCell)
+            {
+                bool rc = false;
+                for (size_t iq=ChainStart; iq<Colored.size(); iq++)
+                    if ((Colors[Colored[iq]] & 1) == BadColor && Board.Remove(Colored[iq],ValBit)) rc = true;
+                if (rc) return true;
+                continue;
+            }
+            
+            // Cells that see both colors. With no two places of the same color in a group,
+            // those cells are all outside the chain
+            for (size_t iq=ChainStart; iq<Colored.size(); iq++)
+            {
+                uint icell = Colored[iq];
+                if ((Colors[icell] & 1) != 0) continue;
+                const uint *Peers = Board.Peers(icell);
+                for (uint ip=0; ip<NumPeers; ip++)
+                    CellMarks[Peers[ip]] = ichain;
+            }
+            bool rc = false;
+            for (size_t iq=ChainStart; iq<Colored.size(); iq++)
+            {
+                uint icell = Colored[iq];
+                if ((Colors[icell] & 1) == 0) continue;
+                const uint *Peers = Board.Peers(icell);
+                for (uint ip=0; ip<NumPeers; ip++)
+                    if (CellMarks[Peers[ip]] == ichain && Board.Remove(Peers[ip],ValBit)) rc = true;
+            }
+            if (rc) return true;
         }
     }
     
-    return false;
-}
-
-bool Itsc(BoardManager &Board)
-{
-    if (ItscBlkRow(Board)) return true;
-    if (ItscBlkCol(Board)) return true;
-    
+    // Nothing to do here until something changes
+    Board.SetChecked(TechColoring,0);
     return false;
 }
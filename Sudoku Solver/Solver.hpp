@@ -9,9 +9,66 @@
 #ifndef Solver_hpp
 #define Solver_hpp
 
-#include "BoardManager.hpp"
 #include "SolverParameters.h"
+#include "SolverStats.h"
+#include "SolverGrade.h"
+#include <stdint.h>
 
-void Solve(BoardManager &Board, SolverParameters &Params);
+typedef unsigned char byte;
+typedef unsigned int uint;
+
+// This class holds the candidate values of every cell of a board,
+// and it runs the solution techniques on them.
+// The candidate values of each cell are a bit vector,
+// and its size is the smallest one that fits the side length.
+// It is created with a block size that will stay fixed
+
+class Solver
+{
+public:
+    virtual ~Solver() {}
+    
+    // Sets the candidates from the cell values, with 0 being no value
+    virtual void SetFromValues(byte *Vals) = 0;
+    
+    // Runs the solution techniques until they make no more changes
+    virtual void Solve(SolverParameters &Params) = 0;
+    
+    // The same, but in grading order, recording the hardest techniques that removed candidates.
+    // It uses no search
+    virtual void Grade(SolverParameters &Params, SolverGrade &Grade) = 0;
+    
+    // Depth-first search: tries each candidate of a cell, runs the techniques,
+    // and backtracks if there is a contradiction.
+    // If it finds a solution, it leaves the candidates at it and returns true,
+    // otherwise it leaves them where they were and returns false.
+    virtual bool Search(SolverParameters &Params) = 0;
+    
+    // Counts solutions with that search, stopping when it reaches MaxCount.
+    // If it finds any, it leaves the candidates at the first one,
+    // otherwise it leaves them where they were.
+    virtual uint CountSolutions(SolverParameters &Params, uint MaxCount) = 0;
+    
+    // Sets the cell values from the candidates:
+    // the candidate value if there is only one, otherwise 0
+    virtual void GetValues(byte *Vals) = 0;
+    
+    // Is value ival a candidate in that cell?
+    virtual bool Avail(uint irow, uint icol, uint ival) = 0;
+    
+    // The candidates of every cell as bit masks, value ival being bit ival-1,
+    // in (SideLength+63)/64 64-bit words per cell
+    virtual void GetCandidates(uint64_t *Masks) = 0;
+    // Sets them from masks like those, as if the techniques had found them
+    virtual void SetCandidates(const uint64_t *Masks) = 0;
+    
+    // The statistics for each technique since they were last cleared, in the order that the techniques run.
+    // There are none unless SOLVER_STATS is 1
+    virtual void GetStats(vector<TechniqueStats> &Stats) = 0;
+    virtual void ClearStats() = 0;
+};
+
+// Makes a solver with the appropriate bit-vector size for the block dimensions
+Solver *MakeSolver(uint BlockRows, uint BlockCols);
 
 #endif /* Solver_hpp */
@@ -0,0 +1,57 @@
+//
+//  SolverGrade.h
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// A puzzle's difficulty, as the hardest solution techniques that it needed.
+// Grading takes one solve: the techniques go from the easiest to the hardest,
+// and they go back to the easiest after each one that removes candidates,
+// so a harder one runs only when all the easier ones have stalled.
+// The order is singles, intersections, visible and hidden sets of size 2, 3, ..., fish of size 2, 3, ...,
+// XY-Wings, XYZ-Wings, then coloring
+
+#ifndef SolverGrade_h
+#define SolverGrade_h
+
+#include "SolverParameters.h"
+
+struct SolverGrade
+{
+    // Whether the techniques solved it, within the solver parameters given for grading
+    bool IsSolved;
+    
+    // The biggest visible-set and hidden-set sizes that removed candidates, with 0 for none
+    unsigned int VisibleSetSize;
+    unsigned int HiddenSetSize;
+    
+    // Whether intersections removed candidates
+    bool UsedIntersections;
+    
+    // The biggest fish that removed candidates, with 0 for none
+    unsigned int FishSize;
+    
+    // Whether the wings and coloring removed candidates
+    bool UsedXYWing;
+    bool UsedXYZWing;
+    bool UsedColoring;
+    
+    SolverGrade(): IsSolved(false), VisibleSetSize(0), HiddenSetSize(0), UsedIntersections(false), FishSize(0),
+        UsedXYWing(false), UsedXYZWing(false), UsedColoring(false) {}
+    
+    // Parameters with only those techniques, which get as far as grading did
+    SolverParameters GetParams() const
+    {
+        SolverParameters Params;
+        Params.MaxVisibleSetSize = VisibleSetSize;
+        Params.MaxHiddenSetSize = HiddenSetSize;
+        Params.UseIntersections = UsedIntersections;
+        Params.MaxFishSize = FishSize;
+        Params.UseXYWing = UsedXYWing;
+        Params.UseXYZWing = UsedXYZWing;
+        Params.UseColoring = UsedColoring;
+        return Params;
+    }
+};
+
+#endif /* SolverGrade_h */
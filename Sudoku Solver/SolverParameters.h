@@ -15,11 +15,42 @@ struct SolverParameters
     unsigned int MaxHiddenSetSize;
     bool UseIntersections;
     
+    // The biggest fish to look for, 2 being X-Wings, 3 Swordfish, and 4 Jellyfish, with 0 or 1 for none
+    unsigned int MaxFishSize;
+    
+    // Short chains: XY-Wings, XYZ-Wings, and single-digit coloring
+    bool UseXYWing;
+    bool UseXYZWing;
+    bool UseColoring;
+    
+    // Search for a solution when the techniques stall
+    bool UseSearch;
+    // The maximum visible and hidden set sizes to use at each search node:
+    // bigger ones mean more work per node but fewer nodes
+    unsigned int SearchSetSize;
+    // The number of threads to split a search across, with 0 being one per processor.
+    // With more than one, which solution is found first can vary from run to run
+    unsigned int SearchThreads;
+    
+    // Solve with an exact-cover search instead of the techniques.
+    // This is faster for bulk solving, but it shows only the solution, not the deductions.
+    // If there is no solution, the techniques run as usual
+    bool UseExactCover;
+    
     // Default: maximum parameter values
+    // Search is off, so that a board shows only what the techniques can find
     SolverParameters() noexcept:
         MaxVisibleSetSize(5),
         MaxHiddenSetSize(5),
-        UseIntersections(true)
+        UseIntersections(true),
+        MaxFishSize(4),
+        UseXYWing(true),
+        UseXYZWing(true),
+        UseColoring(true),
+        UseSearch(false),
+        SearchSetSize(1),
+        SearchThreads(1),
+        UseExactCover(false)
         {}
 };
 
@@ -19,7 +19,11 @@ static NSInteger TagOfSelection(NSSegmentedControl *SegWidget)
 {
     IBOutlet NSSegmentedControl *MaxVisibleSetSizeWidget;
     IBOutlet NSSegmentedControl *MaxHiddenSetSizeWidget;
+    IBOutlet NSSegmentedControl *MaxFishSizeWidget;
     IBOutlet NSButton *UseIntersectionWidget;
+    IBOutlet NSButton *UseXYWingWidget;
+    IBOutlet NSButton *UseXYZWingWidget;
+    IBOutlet NSButton *UseColoringWidget;
 }
 
 @end
@@ -47,14 +51,23 @@ static NSInteger TagOfSelection(NSSegmentedControl *SegWidget)
     
     [MaxVisibleSetSizeWidget selectSegmentWithTag:((NSInteger)(Params.MaxVisibleSetSize))];
     [MaxHiddenSetSizeWidget selectSegmentWithTag:((NSInteger)(Params.MaxHiddenSetSize))];
+    // A fish size of 1 is the same as none
+    [MaxFishSizeWidget selectSegmentWithTag:((NSInteger)(Params.MaxFishSize >= 2 ? MIN(Params.MaxFishSize,4U) : 0))];
     UseIntersectionWidget.state = (Params.UseIntersections ? NSControlStateValueOn : NSControlStateValueOff);
+    UseXYWingWidget.state = (Params.UseXYWing ? NSControlStateValueOn : NSControlStateValueOff);
+    UseXYZWingWidget.state = (Params.UseXYZWing ? NSControlStateValueOn : NSControlStateValueOff);
+    UseColoringWidget.state = (Params.UseColoring ? NSControlStateValueOn : NSControlStateValueOff);
 }
 
 - (SolverParameters)GetSolverParameters
 {
     Params.MaxVisibleSetSize = (unsigned int)TagOfSelection(MaxVisibleSetSizeWidget);
     Params.MaxHiddenSetSize = (unsigned int)TagOfSelection(MaxHiddenSetSizeWidget);
+    Params.MaxFishSize = (unsigned int)TagOfSelection(MaxFishSizeWidget);
     Params.UseIntersections = (UseIntersectionWidget.state != NSControlStateValueOff);
+    Params.UseXYWing = (UseXYWingWidget.state != NSControlStateValueOff);
+    Params.UseXYZWing = (UseXYZWingWidget.state != NSControlStateValueOff);
+    Params.UseColoring = (UseColoringWidget.state != NSControlStateValueOff);
     
     return Params;
 }
@@ -0,0 +1,43 @@
+//
+//  SolverStats.h
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Statistics on how much each solution technique does and what it costs,
+// for choosing solver parameters from evidence.
+// They are collected only if SOLVER_STATS is defined as 1 in the build settings;
+// otherwise the solver has no code for them, and it reports none.
+
+#ifndef SolverStats_h
+#define SolverStats_h
+
+#ifndef SOLVER_STATS
+#define SOLVER_STATS 0
+#endif
+
+#include <string>
+#include <vector>
+using namespace std;
+
+struct TechniqueStats
+{
+    // Vis1, Hid1, Vis2, Hid2, ... for visible and hidden sets of each size,
+    // then FishRow2, FishCol2, FishRow3, FishCol3, ... for the fish of each size,
+    // then ItscBlkRow and ItscBlkCol for the block-row and block-column intersections,
+    // then XYWing, XYZWing, and Coloring
+    string Name;
+    
+    // Passes over the board, and those that removed candidates
+    unsigned long long Invocations, Productive;
+    
+    // Candidates removed, including those in search nodes
+    unsigned long long Eliminated;
+    
+    // Total wall time, in seconds
+    double Time;
+    
+    TechniqueStats(): Invocations(0), Productive(0), Eliminated(0), Time(0) {}
+};
+
+#endif /* SolverStats_h */
@@ -208,7 +208,8 @@ static uint isqrt(uint a) {
     CellContents = [NSArray arrayWithArray:TempCellContents];
     
     // Initialize the history stack
-    HSFE.SetSize(BMFE.GetBoardSize());
+    // with the solved candidates, so that undo and redo do not have to solve again
+    HSFE.SetSize(BMFE.GetBoardSize(),BMFE.GetBoardSize()*BMFE.GetCandidateWords());
     BoardExport(BMFE,HSFE.Add());
     
     // Update the board with the initial data
@@ -240,7 +241,7 @@ static uint isqrt(uint a) {
     TooltipString = [NSMutableString stringWithCapacity:(4*SideLen)];
     
     // Place the tooltips in the starting board
-    [self UpdateBoard:self];
+    [self ShowBoard:self];
 }
 
 - (void)UpdateBoardWithCellContents:(id)sender {
@@ -268,6 +269,14 @@ static uint isqrt(uint a) {
     // Run the solver
     BMFE.SolveAndUpdate();
     
+    // Keep its candidates with the history stack's latest step
+    uint64_t *Masks = HSFE.AddMasks();
+    if (Masks != NULL) BMFE.GetCandidates(Masks);
+    
+    [self ShowBoard:sender];
+}
+
+- (void)ShowBoard:(id)sender {
     // Set the cell-contents widgets
     // Not only the values selected, but also the values' activity
     // Only enabled ones will be those that the solver allows
@@ -441,7 +450,7 @@ static uint isqrt(uint a) {
     if (HistoryBlock == NULL) return;
     
     BoardImport(BMFE,HistoryBlock);
-    [self UpdateBoard:self];
+    [self RestoreBoard:self];
 }
 
 -(IBAction)redo:(id)sender {
@@ -450,7 +459,20 @@ static uint isqrt(uint a) {
     if (HistoryBlock == NULL) return;
     
     BoardImport(BMFE,HistoryBlock);
-    [self UpdateBoard:self];
+    [self RestoreBoard:self];
+}
+
+// Restores the solved board from the history stack's candidates, if it has them,
+// otherwise solves it again
+- (void)RestoreBoard:(id)sender {
+    uint64_t *Masks = HSFE.GetMasks();
+    if (Masks != NULL)
+    {
+        BMFE.SetCandidates(Masks);
+        [self ShowBoard:sender];
+    }
+    else
+        [self UpdateBoard:sender];
 }
 
 - (BOOL)validateUserInterfaceItem:(id <NSValidatedUserInterfaceItem>)Item
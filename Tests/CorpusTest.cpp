@@ -0,0 +1,116 @@
+//
+//  CorpusTest.cpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Solves the benchmark corpus, whose puzzles all have one solution,
+// and checks that each solution is valid, keeps the givens,
+// and is the same with a one-thread and a four-thread search and with exact cover.
+// Exact cover is only for sides up to 16, as in the benchmark,
+// since plain dancing links can take minutes on sparse 25*25 puzzles.
+//
+
+#include "TestCheck.h"
+#include "BoardManager.hpp"
+#include "PuzzleReader.hpp"
+#include <string.h>
+
+
+// Every row, column, and block has each value once, and the givens are kept
+static bool IsSolutionOf(const Puzzle &P, const vector<byte> &Solved)
+{
+    uint SideLength = P.BlockRows*P.BlockCols;
+    if (Solved.size() != P.Vals.size()) return false;
+    for (size_t ic=0; ic<Solved.size(); ic++)
+    {
+        if (Solved[ic] < 1 || Solved[ic] > SideLength) return false;
+        if (P.Vals[ic] != 0 && P.Vals[ic] != Solved[ic]) return false;
+    }
+    
+    for (uint kind=0; kind<3; kind++)
+        for (uint igrp=0; igrp<SideLength; igrp++)
+        {
+            vector<bool> Seen(SideLength+1,false);
+            for (uint k=0; k<SideLength; k++)
+            {
+                uint irow, icol;
+                if (kind == 0) {irow = igrp; icol = k;}
+                else if (kind == 1) {irow = k; icol = igrp;}
+                else
+                {
+                    uint NumBlkCols = SideLength/P.BlockCols;
+                    irow = (igrp/NumBlkCols)*P.BlockRows + k/P.BlockCols;
+                    icol = (igrp%NumBlkCols)*P.BlockCols + k%P.BlockCols;
+                }
+                byte Val = Solved[SideLength*irow+icol];
+                if (Seen[Val]) return false;
+                Seen[Val] = true;
+            }
+        }
+    return true;
+}
+
+static void Solve(const Puzzle &P, SolverParameters &Params, vector<byte> &Solved)
+{
+    BoardManager BM(P.BlockRows,P.BlockCols,Params);
+    BM.SetValues(&P.Vals[0]);
+    BM.SolveAndUpdate();
+    Solved.resize(P.Vals.size());
+    BM.GetValues(&Solved[0]);
+}
+
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr,"Usage: %s corpus-file ...\n",argv[0]);
+        return 1;
+    }
+    
+    SolverParameters Search;
+    Search.UseSearch = true;
+    SolverParameters ParallelSearch = Search;
+    ParallelSearch.SearchThreads = 4;
+    SolverParameters ExactCover;
+    ExactCover.UseExactCover = true;
+    const uint MaxExactCoverSide = 16;
+    
+    size_t NumPuzzles = 0;
+    for (int iarg=1; iarg<argc; iarg++)
+    {
+        vector<Puzzle> Puzzles;
+        string Error;
+        PuzzleMap Contents;
+        bool IsRead = Contents.Open(argv[iarg],Error) &&
+            ReadPuzzles(Contents.Begin(),Contents.End(),PuzzleFormatText,0,0,Puzzles,Error);
+        if (!IsRead) fprintf(stderr,"%s: %s\n",argv[iarg],Error.c_str());
+        CHECK(IsRead);
+        CHECK(!Puzzles.empty());
+        
+        for (size_t ip=0; ip<Puzzles.size(); ip++)
+        {
+            const Puzzle &P = Puzzles[ip];
+            vector<byte> Solved, ParallelSolved;
+            Solve(P,Search,Solved);
+            Solve(P,ParallelSearch,ParallelSolved);
+            
+            bool IsOK = IsSolutionOf(P,Solved);
+            if (!IsOK) fprintf(stderr,"%s: puzzle %zu not solved\n",argv[iarg],ip+1);
+            CHECK(IsOK);
+            CHECK(ParallelSolved == Solved);
+            
+            if (P.BlockRows*P.BlockCols <= MaxExactCoverSide)
+            {
+                vector<byte> ExactSolved;
+                Solve(P,ExactCover,ExactSolved);
+                CHECK(ExactSolved == Solved);
+            }
+            NumPuzzles++;
+        }
+    }
+    
+    printf("%zu puzzles\n",NumPuzzles);
+    return TestResult();
+}
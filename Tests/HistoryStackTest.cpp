@@ -0,0 +1,84 @@
+//
+//  HistoryStackTest.cpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Adds steps of a few changes, stored as changes, and of many, stored as full frames,
+// then goes back to the start and forward to the end, checking each block on the way.
+// Then adding a step after going back must drop the steps after it.
+//
+
+#include "TestCheck.h"
+#include "HistoryStack.hpp"
+#include <string.h>
+#include <random>
+
+
+static bool IsBlock(const byte *Block, const vector<byte> &Expected)
+{
+    return Block != NULL && memcmp(Block,&Expected[0],Expected.size()) == 0;
+}
+
+
+int main()
+{
+    const uint Size = 81;
+    HistoryStack History(Size);
+    CHECK(History.GetBlock() == NULL);
+    CHECK(!History.CanGoBack());
+    CHECK(!History.CanGoFwd());
+    
+    // What each step should be
+    vector< vector<byte> > Blocks;
+    vector<byte> Block(Size,0);
+    mt19937 Random(1);
+    
+    const uint NumSteps = 40;
+    for (uint istep=0; istep<NumSteps; istep++)
+    {
+        // Every fifth step changes nearly everything, the others only a few cells
+        uint NumChanges = (istep % 5 == 4) ? Size : 1 + Random() % 4;
+        for (uint ichg=0; ichg<NumChanges; ichg++)
+            Block[Random() % Size] = 1 + Random() % 9;
+        
+        byte *Added = History.Add();
+        CHECK(Added != NULL);
+        memcpy(Added,&Block[0],Size);
+        Blocks.push_back(Block);
+        
+        CHECK(IsBlock(History.GetBlock(),Block));
+        CHECK(!History.CanGoFwd());
+    }
+    
+    // Back to the first step
+    for (uint istep=NumSteps-1; istep>0; istep--)
+        CHECK(IsBlock(History.GoBack(),Blocks[istep-1]));
+    CHECK(!History.CanGoBack());
+    CHECK(History.GoBack() == NULL);
+    CHECK(IsBlock(History.GetBlock(),Blocks[0]));
+    
+    // Forward to the last one
+    for (uint istep=1; istep<NumSteps; istep++)
+        CHECK(IsBlock(History.GoFwd(),Blocks[istep]));
+    CHECK(!History.CanGoFwd());
+    CHECK(History.GoFwd() == NULL);
+    
+    // A new step in the middle replaces the ones after it
+    const uint NumBack = 10;
+    for (uint iback=0; iback<NumBack; iback++)
+        History.GoBack();
+    uint Middle = NumSteps - 1 - NumBack;
+    CHECK(IsBlock(History.GetBlock(),Blocks[Middle]));
+    
+    Block = Blocks[Middle];
+    Block[0] = (Block[0] % 9) + 1;
+    memcpy(History.Add(),&Block[0],Size);
+    CHECK(!History.CanGoFwd());
+    CHECK(IsBlock(History.GetBlock(),Block));
+    CHECK(IsBlock(History.GoBack(),Blocks[Middle]));
+    CHECK(IsBlock(History.GoFwd(),Block));
+    CHECK(!History.CanGoFwd());
+    
+    return TestResult();
+}
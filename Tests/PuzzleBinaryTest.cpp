@@ -0,0 +1,219 @@
+//
+//  PuzzleBinaryTest.cpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Writes containers of random puzzles, some with solutions, and reads them back:
+// in order, by seeking through the sparse index, and through PuzzleScanner.
+// Then checks that damaged headers, trailers, indexes, and cell values are caught.
+//
+
+#include "TestCheck.h"
+#include "PuzzleBinary.hpp"
+#include "PuzzleReader.hpp"
+#include <string.h>
+#include <random>
+
+
+struct Record
+{
+    vector<byte> Vals, Solved;
+    bool HasSolution;
+};
+
+static void MakeRecords(uint BlockRows, uint BlockCols, uint NumRecords, vector<Record> &Records)
+{
+    uint SideLength = BlockRows*BlockCols;
+    uint BoardSize = SideLength*SideLength;
+    mt19937 Random(BlockRows*16 + BlockCols);
+    Records.resize(NumRecords);
+    for (uint irec=0; irec<NumRecords; irec++)
+    {
+        Record &R = Records[irec];
+        R.Vals.resize(BoardSize);
+        R.Solved.resize(BoardSize);
+        for (uint ic=0; ic<BoardSize; ic++)
+        {
+            R.Vals[ic] = Random() % (SideLength+1);
+            R.Solved[ic] = 1 + Random() % SideLength;
+        }
+        R.HasSolution = (irec % 3 != 1);
+    }
+}
+
+// The whole container, written to a temporary file
+static bool WriteContainer(uint BlockRows, uint BlockCols, const vector<Record> &Records, vector<char> &Data)
+{
+    FILE *File = tmpfile();
+    if (File == NULL) return false;
+    PuzzleBinaryWriter Writer(File,BlockRows,BlockCols);
+    for (size_t irec=0; irec<Records.size(); irec++)
+    {
+        const Record &R = Records[irec];
+        Writer.Write(&R.Vals[0],R.HasSolution ? &R.Solved[0] : NULL);
+    }
+    bool IsOK = Writer.Finish();
+    
+    long Size = ftell(File);
+    rewind(File);
+    Data.resize(Size);
+    if (Size > 0 && fread(&Data[0],1,Size,File) != (size_t)Size) IsOK = false;
+    fclose(File);
+    return IsOK;
+}
+
+static bool ReadsRecord(PuzzleBinaryReader &Reader, const Record &R)
+{
+    vector<byte> Vals(R.Vals.size()), Solved(R.Vals.size(),0);
+    bool HasSolution = false;
+    if (!Reader.Next(&Vals[0],&Solved[0],&HasSolution)) return false;
+    if (Vals != R.Vals || HasSolution != R.HasSolution) return false;
+    return !R.HasSolution || Solved == R.Solved;
+}
+
+static void TestRoundTrip(uint BlockRows, uint BlockCols, uint NumRecords)
+{
+    vector<Record> Records;
+    MakeRecords(BlockRows,BlockCols,NumRecords,Records);
+    vector<char> Data;
+    CHECK(WriteContainer(BlockRows,BlockCols,Records,Data));
+    const char *Begin = &Data[0];
+    const char *End = Begin + Data.size();
+    CHECK(IsPuzzleBinary(Begin,End));
+    
+    PuzzleBinaryReader Reader;
+    string Error;
+    CHECK(Reader.Open(Begin,End,Error));
+    CHECK(Reader.GetBlockRows() == BlockRows);
+    CHECK(Reader.GetBlockCols() == BlockCols);
+    CHECK(Reader.GetNumRecords() == NumRecords);
+    
+    // In order
+    for (uint irec=0; irec<NumRecords; irec++)
+        CHECK(ReadsRecord(Reader,Records[irec]));
+    vector<byte> Vals(Records.empty() ? 1 : Records[0].Vals.size());
+    CHECK(!Reader.Next(&Vals[0]));
+    CHECK(!Reader.HasError());
+    
+    // At and around the indexed records, one every 64, and at the end
+    uint Targets[] = {0, 1, 63, 64, 65, 127, 128, 150, NumRecords-1, NumRecords/2};
+    for (uint it=0; it<sizeof(Targets)/sizeof(Targets[0]); it++)
+    {
+        uint irec = Targets[it];
+        if (irec >= NumRecords) continue;
+        CHECK(Reader.Seek(irec));
+        CHECK(ReadsRecord(Reader,Records[irec]));
+    }
+    CHECK(Reader.Seek(NumRecords));
+    CHECK(!Reader.Next(&Vals[0]));
+    CHECK(!Reader.Seek(NumRecords+1));
+    
+    // As the batch solver reads it
+    vector<Puzzle> Puzzles;
+    CHECK(ReadPuzzles(Begin,End,PuzzleFormatAuto,0,0,Puzzles,Error));
+    CHECK(Puzzles.size() == NumRecords);
+    for (size_t ip=0; ip<Puzzles.size() && ip<Records.size(); ip++)
+    {
+        CHECK(Puzzles[ip].BlockRows == BlockRows && Puzzles[ip].BlockCols == BlockCols);
+        CHECK(Puzzles[ip].Vals == Records[ip].Vals);
+    }
+}
+
+static bool Opens(const vector<char> &Data)
+{
+    PuzzleBinaryReader Reader;
+    string Error;
+    bool IsOK = Reader.Open(&Data[0],&Data[0]+Data.size(),Error);
+    if (!IsOK) CHECK(!Error.empty());
+    return IsOK;
+}
+
+static void PutUint64(char *Dest, uint64_t Val)
+{
+    for (uint ib=0; ib<8; ib++)
+        Dest[ib] = (char)(Val >> (8*ib));
+}
+
+static void TestDamage()
+{
+    const uint NumRecords = 100;
+    vector<Record> Records;
+    MakeRecords(3,3,NumRecords,Records);
+    vector<char> Good;
+    CHECK(WriteContainer(3,3,Records,Good));
+    CHECK(Opens(Good));
+    
+    // The trailer is the last 24 bytes: index offset, number of records, magic
+    size_t TrailerPos = Good.size() - 24;
+    vector<char> Data;
+    
+    Data.assign(Good.begin(),Good.end()-1);
+    CHECK(!Opens(Data));
+    
+    Data = Good;
+    Data[Data.size()-2] = 'X';
+    CHECK(!Opens(Data));
+    
+    Data = Good;
+    PutUint64(&Data[TrailerPos],8);
+    CHECK(!Opens(Data));
+    
+    Data = Good;
+    PutUint64(&Data[TrailerPos],Good.size());
+    CHECK(!Opens(Data));
+    
+    // More records than the index has entries for
+    Data = Good;
+    PutUint64(&Data[TrailerPos+8],NumRecords+64);
+    CHECK(!Opens(Data));
+    
+    // The header: version, then block rows, then bits per cell
+    Data = Good;
+    Data[4] = 2;
+    CHECK(!Opens(Data));
+    
+    Data = Good;
+    Data[6] = 0;
+    CHECK(!Opens(Data));
+    
+    Data = Good;
+    Data[8] = 5;
+    CHECK(!Opens(Data));
+    
+    // An index entry pointing into the trailer is caught when seeking with it
+    Data = Good;
+    size_t IndexPos = TrailerPos - 2*8;
+    PutUint64(&Data[IndexPos+8],TrailerPos);
+    {
+        PuzzleBinaryReader Reader;
+        string Error;
+        CHECK(Reader.Open(&Data[0],&Data[0]+Data.size(),Error));
+        CHECK(!Reader.Seek(64+1));
+        CHECK(Reader.HasError());
+    }
+    
+    // A cell value of 15 in a 9*9 puzzle: the first record's first cell, after its flags byte
+    Data = Good;
+    Data[16+1] = (char)0x0f;
+    {
+        PuzzleBinaryReader Reader;
+        string Error;
+        CHECK(Reader.Open(&Data[0],&Data[0]+Data.size(),Error));
+        vector<byte> Vals(81);
+        CHECK(!Reader.Next(&Vals[0]));
+        CHECK(Reader.HasError());
+    }
+}
+
+
+int main()
+{
+    // 4 bits per cell, then 5 and 6, which span bytes
+    TestRoundTrip(3,3,200);
+    TestRoundTrip(4,4,130);
+    TestRoundTrip(4,8,70);
+    TestRoundTrip(3,3,0);
+    TestDamage();
+    return TestResult();
+}
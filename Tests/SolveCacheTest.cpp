@@ -0,0 +1,167 @@
+//
+//  SolveCacheTest.cpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Checks the cache's keys, its least-recently-used eviction at its byte bound,
+// and that a board manager gets the same result from it as from solving.
+//
+
+#include "TestCheck.h"
+#include "SolveCache.hpp"
+#include "BoardManager.hpp"
+
+
+static const uint NumMasks = 81;
+
+static void MakeTestKey(byte FirstVal, string &Key)
+{
+    vector<byte> Vals(81,0);
+    Vals[0] = FirstVal;
+    SolveCache::MakeKey(3,3,SolverParameters(),&Vals[0],Vals.size(),Key);
+}
+
+static void TestKeys()
+{
+    vector<byte> Vals(81,0);
+    Vals[40] = 5;
+    SolverParameters Params;
+    string Key, Other;
+    SolveCache::MakeKey(3,3,Params,&Vals[0],Vals.size(),Key);
+    
+    // Only the number of search threads leaves the key the same
+    SolverParameters Threaded = Params;
+    Threaded.SearchThreads = 4;
+    SolveCache::MakeKey(3,3,Threaded,&Vals[0],Vals.size(),Other);
+    CHECK(Other == Key);
+    
+    SolverParameters NoFish = Params;
+    NoFish.MaxFishSize = 0;
+    SolveCache::MakeKey(3,3,NoFish,&Vals[0],Vals.size(),Other);
+    CHECK(Other != Key);
+    
+    SolverParameters Search = Params;
+    Search.UseSearch = true;
+    SolveCache::MakeKey(3,3,Search,&Vals[0],Vals.size(),Other);
+    CHECK(Other != Key);
+    
+    vector<byte> OtherVals = Vals;
+    OtherVals[40] = 6;
+    SolveCache::MakeKey(3,3,Params,&OtherVals[0],OtherVals.size(),Other);
+    CHECK(Other != Key);
+    
+    // Same number of cells, different block dimensions
+    vector<byte> Vals2x6(144,0), Vals3x4(144,0);
+    SolveCache::MakeKey(2,6,Params,&Vals2x6[0],Vals2x6.size(),Key);
+    SolveCache::MakeKey(3,4,Params,&Vals3x4[0],Vals3x4.size(),Other);
+    CHECK(Other != Key);
+}
+
+static void TestFindAndEvict()
+{
+    vector<uint64_t> Masks(NumMasks), Found(NumMasks);
+    string Keys[4];
+    for (uint ik=0; ik<4; ik++)
+        MakeTestKey(ik+1,Keys[ik]);
+    
+    // The size of one entry, all of them being the same size
+    size_t EntryBytes;
+    {
+        SolveCache Cache(1 << 20);
+        Cache.Add(Keys[0],&Masks[0],NumMasks);
+        EntryBytes = Cache.GetCounts().Bytes;
+        CHECK(EntryBytes > 0);
+    }
+    
+    SolveCache Cache(3*EntryBytes);
+    for (uint ik=0; ik<3; ik++)
+    {
+        fill(Masks.begin(),Masks.end(),ik+1);
+        CHECK(!Cache.Find(Keys[ik],&Found[0],NumMasks));
+        Cache.Add(Keys[ik],&Masks[0],NumMasks);
+    }
+    SolveCacheCounts Counts = Cache.GetCounts();
+    CHECK(Counts.Entries == 3);
+    CHECK(Counts.Bytes == 3*EntryBytes);
+    CHECK(Counts.Misses == 3);
+    CHECK(Counts.Evictions == 0);
+    
+    // A hit copies the masks and makes the first one the most recently used, so the second goes next
+    CHECK(Cache.Find(Keys[0],&Found[0],NumMasks));
+    CHECK(Found[0] == 1 && Found[NumMasks-1] == 1);
+    // A different number of masks is a miss
+    CHECK(!Cache.Find(Keys[0],&Found[0],NumMasks-1));
+    
+    Cache.Add(Keys[3],&Masks[0],NumMasks);
+    Counts = Cache.GetCounts();
+    CHECK(Counts.Entries == 3);
+    CHECK(Counts.Bytes <= 3*EntryBytes);
+    CHECK(Counts.Evictions == 1);
+    CHECK(!Cache.Find(Keys[1],&Found[0],NumMasks));
+    CHECK(Cache.Find(Keys[0],&Found[0],NumMasks));
+    CHECK(Cache.Find(Keys[2],&Found[0],NumMasks));
+    CHECK(Found[0] == 3);
+    CHECK(Cache.Find(Keys[3],&Found[0],NumMasks));
+    
+    // Shrinking the bound drops the least recently used, here the first one
+    Cache.SetMaxBytes(2*EntryBytes);
+    Counts = Cache.GetCounts();
+    CHECK(Counts.Entries == 2);
+    CHECK(Counts.Evictions == 2);
+    CHECK(!Cache.Find(Keys[0],&Found[0],NumMasks));
+    CHECK(Cache.Find(Keys[3],&Found[0],NumMasks));
+    
+    // A result bigger than the whole bound is not kept
+    SolveCache Small(EntryBytes-1);
+    Small.Add(Keys[0],&Masks[0],NumMasks);
+    CHECK(Small.GetCounts().Entries == 0);
+    CHECK(!Small.Find(Keys[0],&Found[0],NumMasks));
+    
+    Cache.Clear();
+    Counts = Cache.GetCounts();
+    CHECK(Counts.Entries == 0 && Counts.Bytes == 0 && Counts.Hits == 0);
+}
+
+// A hard puzzle, solved with search
+static void TestBoardManager()
+{
+    const char *Puzzle =
+        "800000000003600000070090200050007000000045700000100030001000068008500010090000400";
+    vector<byte> Vals(81), Solved(81), CachedSolved(81);
+    for (uint ic=0; ic<81; ic++)
+        Vals[ic] = Puzzle[ic] - '0';
+    
+    SolverParameters Params;
+    Params.UseSearch = true;
+    SolveCache Cache(1 << 20);
+    
+    BoardManager Plain(3,3,Params);
+    Plain.SetValues(&Vals[0]);
+    Plain.SolveAndUpdate();
+    Plain.GetValues(&Solved[0]);
+    CHECK(find(Solved.begin(),Solved.end(),0) == Solved.end());
+    
+    BoardManager Cached(3,3,Params);
+    Cached.SetCache(&Cache);
+    for (uint irep=0; irep<2; irep++)
+    {
+        Cached.SetValues(&Vals[0]);
+        Cached.SolveAndUpdate();
+        Cached.GetValues(&CachedSolved[0]);
+        CHECK(CachedSolved == Solved);
+    }
+    SolveCacheCounts Counts = Cache.GetCounts();
+    CHECK(Counts.Misses == 1);
+    CHECK(Counts.Hits == 1);
+    CHECK(Counts.Entries == 1);
+}
+
+
+int main()
+{
+    TestKeys();
+    TestFindAndEvict();
+    TestBoardManager();
+    return TestResult();
+}
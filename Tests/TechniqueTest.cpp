@@ -0,0 +1,214 @@
+//
+//  TechniqueTest.cpp
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// Sets up candidates with a known pattern on an otherwise open 9*9 board:
+// fish, an XY-Wing, an XYZ-Wing, and a coloring chain.
+// For each, it runs only the technique under test and checks that it removes the candidates it should
+// and no others, and that it removes nothing when it is turned off.
+//
+
+#include "TestCheck.h"
+#include "Solver.hpp"
+
+
+static const uint SideLength = 9;
+static const uint64_t AllVals = (1 << SideLength) - 1;
+
+// One mask per cell, every value open
+struct Candidates
+{
+    uint64_t Masks[SideLength*SideLength];
+    
+    Candidates() {for (uint ic=0; ic<SideLength*SideLength; ic++) Masks[ic] = AllVals;}
+    
+    uint64_t &operator()(uint irow, uint icol) {return Masks[SideLength*irow+icol];}
+    
+    // Leaves value ival in that row only in the columns in ColMask
+    void KeepInRow(uint irow, uint ival, uint ColMask)
+    {
+        for (uint icol=0; icol<SideLength; icol++)
+            if (!(ColMask & (1 << icol))) (*this)(irow,icol) &= ~(uint64_t(1) << (ival-1));
+    }
+    
+    // The same for a column
+    void KeepInCol(uint icol, uint ival, uint RowMask)
+    {
+        for (uint irow=0; irow<SideLength; irow++)
+            if (!(RowMask & (1 << irow))) (*this)(irow,icol) &= ~(uint64_t(1) << (ival-1));
+    }
+};
+
+// No sets, intersections, or other techniques
+static SolverParameters NoTechniques()
+{
+    SolverParameters Params;
+    Params.MaxVisibleSetSize = 0;
+    Params.MaxHiddenSetSize = 0;
+    Params.UseIntersections = false;
+    Params.MaxFishSize = 0;
+    Params.UseXYWing = false;
+    Params.UseXYZWing = false;
+    Params.UseColoring = false;
+    return Params;
+}
+
+// Which candidates the solver removed from Before
+static void Solve(Candidates &Before, SolverParameters &Params, Candidates &Removed)
+{
+    Solver *S = MakeSolver(3,3);
+    S->SetCandidates(Before.Masks);
+    S->Solve(Params);
+    Candidates After;
+    S->GetCandidates(After.Masks);
+    delete S;
+    for (uint ic=0; ic<SideLength*SideLength; ic++)
+        Removed.Masks[ic] = Before.Masks[ic] & ~After.Masks[ic];
+}
+
+static bool RemovesNothing(Candidates &Before, SolverParameters &Params)
+{
+    Candidates Removed;
+    Solve(Before,Params,Removed);
+    for (uint ic=0; ic<SideLength*SideLength; ic++)
+        if (Removed.Masks[ic] != 0) return false;
+    return true;
+}
+
+// Whether the technique's removals are only value ival from the cells in the list
+static bool RemovesOnly(Candidates &Removed, uint ival, const uint (*Cells)[2], uint NumCells)
+{
+    Candidates Expected;
+    for (uint ic=0; ic<SideLength*SideLength; ic++)
+        Expected.Masks[ic] = 0;
+    for (uint ic=0; ic<NumCells; ic++)
+        Expected(Cells[ic][0],Cells[ic][1]) = uint64_t(1) << (ival-1);
+    for (uint ic=0; ic<SideLength*SideLength; ic++)
+        if (Removed.Masks[ic] != Expected.Masks[ic]) return false;
+    return true;
+}
+
+// Value 1 of rows 0 and 4 is only in columns 1 and 7,
+// so the other rows lose it from those columns
+static void TestXWing()
+{
+    Candidates Before;
+    uint Cols = (1 << 1) | (1 << 7);
+    Before.KeepInRow(0,1,Cols);
+    Before.KeepInRow(4,1,Cols);
+    
+    SolverParameters Params = NoTechniques();
+    CHECK(RemovesNothing(Before,Params));
+    
+    Params.MaxFishSize = 2;
+    Candidates Removed;
+    Solve(Before,Params,Removed);
+    for (uint irow=0; irow<SideLength; irow++)
+        for (uint icol=0; icol<SideLength; icol++)
+        {
+            bool IsCover = (Cols & (1 << icol)) && irow != 0 && irow != 4;
+            CHECK(Removed(irow,icol) == (IsCover ? 1 : 0));
+        }
+}
+
+// Value 5 of rows 0, 3, and 6 is only in columns 0, 4, and 8, two in each row,
+// so the other rows lose it from those columns. It needs a fish size of 3
+static void TestSwordfish()
+{
+    Candidates Before;
+    Before.KeepInRow(0,5,(1 << 0) | (1 << 4));
+    Before.KeepInRow(3,5,(1 << 4) | (1 << 8));
+    Before.KeepInRow(6,5,(1 << 0) | (1 << 8));
+    uint Cols = (1 << 0) | (1 << 4) | (1 << 8);
+    
+    SolverParameters Params = NoTechniques();
+    Params.MaxFishSize = 2;
+    CHECK(RemovesNothing(Before,Params));
+    
+    Params.MaxFishSize = 3;
+    Candidates Removed;
+    Solve(Before,Params,Removed);
+    for (uint irow=0; irow<SideLength; irow++)
+        for (uint icol=0; icol<SideLength; icol++)
+        {
+            bool IsCover = (Cols & (1 << icol)) && irow % 3 != 0;
+            CHECK(Removed(irow,icol) == (IsCover ? uint64_t(1) << 4 : 0));
+        }
+}
+
+// A pivot with 1 and 2 sees a pincer with 1 and 3 in its row and one with 2 and 3 in its column.
+// One of the pincers has 3, so the only other cell that sees both of them loses it
+static void TestXYWing()
+{
+    Candidates Before;
+    Before(0,0) = 0x3;
+    Before(0,5) = 0x5;
+    Before(5,0) = 0x6;
+    
+    SolverParameters Params = NoTechniques();
+    Params.UseXYZWing = true;
+    CHECK(RemovesNothing(Before,Params));
+    
+    Params = NoTechniques();
+    Params.UseXYWing = true;
+    Candidates Removed;
+    Solve(Before,Params,Removed);
+    const uint Cells[][2] = {{5,5}};
+    CHECK(RemovesOnly(Removed,3,Cells,1));
+}
+
+// A pivot with 1, 2, and 3 sees a pincer with 1 and 3 in its block and one with 2 and 3 in its row.
+// One of the three has 3, so the cells that see all of them, in that row and block, lose it
+static void TestXYZWing()
+{
+    Candidates Before;
+    Before(0,0) = 0x7;
+    Before(1,1) = 0x5;
+    Before(0,5) = 0x6;
+    
+    SolverParameters Params = NoTechniques();
+    Params.UseXYWing = true;
+    CHECK(RemovesNothing(Before,Params));
+    
+    Params = NoTechniques();
+    Params.UseXYZWing = true;
+    Candidates Removed;
+    Solve(Before,Params,Removed);
+    const uint Cells[][2] = {{0,1},{0,2}};
+    CHECK(RemovesOnly(Removed,3,Cells,2));
+}
+
+// Value 1 is only at (0,0) and (0,4) in row 0, at (0,4) and (4,4) in column 4,
+// and at (4,4) and (3,5) in the middle block, making a chain whose ends have different colors.
+// One of those ends has it, so (3,0), which sees both, loses it
+static void TestColoring()
+{
+    Candidates Before;
+    Before.KeepInRow(0,1,(1 << 0) | (1 << 4));
+    Before.KeepInCol(4,1,(1 << 0) | (1 << 4));
+    for (uint irow=3; irow<6; irow++)
+        for (uint icol=3; icol<6; icol++)
+            if (!(irow == 4 && icol == 4) && !(irow == 3 && icol == 5)) Before(irow,icol) &= ~uint64_t(1);
+    
+    SolverParameters Params = NoTechniques();
+    CHECK(RemovesNothing(Before,Params));
+    
+    Params.UseColoring = true;
+    Candidates Removed;
+    Solve(Before,Params,Removed);
+    const uint Cells[][2] = {{3,0}};
+    CHECK(RemovesOnly(Removed,1,Cells,1));
+}
+
+
+int main()
+{
+    TestXWing();
+    TestSwordfish();
+    TestXYWing();
+    TestXYZWing();
+    TestColoring();
+    return TestResult();
+}
@@ -0,0 +1,33 @@
+//
+//  TestCheck.h
+//  Sudoku Solver
+//
+//  Copyright © 2026 Loren Petrich. All rights reserved.
+//
+// A minimal checking macro for the tests, so that they need nothing but the solver's files.
+// Each test program returns TestResult() from main(), which is nonzero if any check failed.
+//
+
+#ifndef TestCheck_h
+#define TestCheck_h
+
+#include <stdio.h>
+
+static unsigned int NumChecksFailed = 0;
+
+#define CHECK(Cond) \
+    do { \
+        if (!(Cond)) \
+        { \
+            fprintf(stderr,"%s:%d: check failed: %s\n",__FILE__,__LINE__,#Cond); \
+            NumChecksFailed++; \
+        } \
+    } while (0)
+
+static inline int TestResult()
+{
+    if (NumChecksFailed > 0) fprintf(stderr,"%u checks failed\n",NumChecksFailed);
+    return (NumChecksFailed > 0) ? 1 : 0;
+}
+
+#endif /* TestCheck_h */